@@ -35,19 +35,77 @@
    memory for performance every time.
 */
 
+// 5. WHAT ABOUT PAGE SIZE?
+/*
+   64 MB of structs on 4K pages is 16,384 pages – far more than the dTLB
+   covers, so part of what we time is page walks, not cache lines.
+   Run with --pages=thp|2m|1g to back both arrays with huge pages and
+   compare the dTLB miss counts printed next to each timing.
+*/
+
+// 6. HOW SHOULD PRODUCTION CODE DO IT?
+/*
+   Not with aligned_alloc + reinterpret_cast + memset. Use aligned_array<T>
+   (common/aligned_array.hpp): it checks alignof/sizeof at compile time,
+   constructs and destroys elements, and can sit on huge pages.
+   The benchmark runs the aligned case both ways to show it costs nothing.
+*/
+
+// 7. WHEN DOES MISALIGNMENT REALLY HURT?
+/*
+   One thread can't saturate the memory controller, so the extra line
+   touched per record mostly hides behind latency. With every core
+   streaming, bandwidth is the bottleneck and the waste shows up directly.
+
+   --mode=parallel [--threads=N] splits both arrays across 1, 2, 4 ... N
+   pinned threads and prints aggregate GB/s for each count. The arrays are
+   sized to at least twice the LLC and read once, and each thread
+   first-touches its own slice, so what we time is DRAM, not cache.
+*/
+
+// 8. CAN SOFTWARE PREFETCH HELP?
+/*
+   __builtin_prefetch(addr, 0, hint) asks for a line `distance` elements
+   ahead of the one we're working on. Too short and it arrives late, too
+   long and it is evicted before use; the best value depends on the access
+   pattern and how far down the hierarchy the working set lives.
+
+   --mode=prefetch sweeps distance 0..64 and hint T0/T1/T2/NTA for
+   sequential, strided and gather walks over both arrays, at several
+   working-set sizes, and prints the best setting for each combination.
+   The winner is then re-timed against no prefetch, alternating, and the
+   medians are what gets printed.
+*/
+
 
 
 #include <iostream>
 #include <chrono>
-#include <thread>
 #include <vector>
-#include <cstdlib>     // For aligned_alloc (C++17)
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <cstdint>     // For uintptr_t
 #include <cstring>     // For memset
 #include <cassert>
+#include <unistd.h>    // For sysconf
+
+#include "aligned_array.hpp"
+#include "bench_options.hpp"
+#include "huge_pages.hpp"
+#include "perf_counters.hpp"
+#include "thread_affinity.hpp"
+#include "thread_pool.hpp"
 
 constexpr size_t NUM_STRUCTS = 1'000'000;
 constexpr size_t NUM_ITERATIONS = 100;
 constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t MISALIGN_OFFSET = 16; // where glibc's new[] lands inside a fresh mmap chunk
+constexpr size_t PREFETCH_ACCESSES = 4'000'000; // records touched per prefetch measurement
+constexpr size_t PREFETCH_STRIDE = 16;          // records between strided accesses (1 KB)
+constexpr size_t MAX_PREFETCH_DISTANCE = 64;
+constexpr size_t PREFETCH_CONFIRM_RUNS = 5;     // baseline/best pairs behind each reported number
 
 // unaligned
 struct UnalignedStruct {
@@ -63,7 +121,9 @@ struct alignas(CACHE_LINE_SIZE) AlignedStruct {
 template<typename T>
 long long benchmarkAccess(T* arr, size_t count, const std::string& label) {
     volatile long long sum = 0; 
+    PerfCounter dtlbMisses(PerfEvent::DtlbLoadMisses);
 
+    dtlbMisses.start();
     auto start = std::chrono::high_resolution_clock::now();
 
     for (size_t iter = 0; iter < NUM_ITERATIONS; ++iter) {
@@ -75,31 +135,322 @@ long long benchmarkAccess(T* arr, size_t count, const std::string& label) {
     }
 
     auto end = std::chrono::high_resolution_clock::now();
+    long long misses = dtlbMisses.stop();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
-    std::cout << label << " took: " << duration << " ms, dummy sum: " << sum << "\n";
+    std::cout << label << " took: " << duration << " ms, dTLB misses: " << formatCount(misses)
+              << ", dummy sum: " << sum << "\n";
     return duration;
 }
 
-int main() {
-    std::cout << "🔍 Testing cache line alignment impact...\n";
+// Same walk as benchmarkAccess, but through the container's begin()/end() and
+// element references, so aligned_array's accessors are on the timed path.
+template<typename Container>
+long long benchmarkContainerAccess(const Container& arr, const std::string& label) {
+    volatile long long sum = 0;
+    PerfCounter dtlbMisses(PerfEvent::DtlbLoadMisses);
+
+    dtlbMisses.start();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t iter = 0; iter < NUM_ITERATIONS; ++iter) {
+        for (const auto& element : arr) {
+            for (int j = 0; j < 16; ++j) {
+                sum += element.data[j];
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    long long misses = dtlbMisses.stop();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << label << " took: " << duration << " ms, dTLB misses: " << formatCount(misses)
+              << ", dummy sum: " << sum << "\n";
+    return duration;
+}
+
+// One partial sum per thread, each on its own line so the workers don't false-share.
+struct alignas(CACHE_LINE_SIZE) PaddedSum {
+    long long value = 0;
+};
+
+// Records per array in parallel mode: at least twice the LLC, so the slices
+// can't settle into L2/L3 however many threads share them.
+size_t parallelStructCount() {
+    long llcBytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    size_t bytes = std::max(NUM_STRUCTS * sizeof(AlignedStruct), 2 * static_cast<size_t>(std::max(llcBytes, 0L)));
+    return bytes / sizeof(AlignedStruct);
+}
+
+// Each pinned worker first-touches its own slice, so the pages sit on its
+// node, then makes one timed pass over it. Returns aggregate read GB/s.
+template<typename T>
+double benchmarkParallelAccess(StaticThreadPool& pool, T* arr, size_t count, const std::string& label) {
+    size_t numThreads = pool.size();
+    std::vector<PaddedSum> partials(numThreads);
+
+    pool.run([&](size_t t) {
+        auto [begin, end] = staticPartition(count, t, numThreads);
+        std::memset(static_cast<void*>(arr + begin), 0, (end - begin) * sizeof(T));
+    });
+
+    auto start = std::chrono::high_resolution_clock::now();
+    pool.run([&](size_t t) {
+        auto [begin, end] = staticPartition(count, t, numThreads);
+        long long sum = 0;
+        for (size_t i = begin; i < end; ++i) {
+            for (int j = 0; j < 16; ++j) {
+                sum += arr[i].data[j];
+            }
+        }
+        partials[t].value = sum;
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+
+    long long sum = 0;
+    for (const auto& p : partials) sum += p.value;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double gbPerSec = double(sizeof(T)) * count / seconds / 1e9;
+    std::cout << label << " x" << numThreads << " threads took: "
+              << static_cast<long long>(seconds * 1000) << " ms, " << gbPerSec
+              << " GB/s, dummy sum: " << sum << "\n";
+    return gbPerSec;
+}
+
+// Fresh arrays for every thread count, so first-touch placement always
+// matches the slices that get read.
+void runParallelMode(PagePolicy policy, size_t maxThreads) {
+    size_t count = parallelStructCount();
+    std::cout << "\n🧵 Parallel bandwidth mode (" << count * sizeof(AlignedStruct) / (1024 * 1024)
+              << " MB per array, up to " << maxThreads << " pinned threads)\n";
+
+    size_t unalignedBytes = sizeof(UnalignedStruct) * count + MISALIGN_OFFSET;
+    size_t alignedBytes = sizeof(AlignedStruct) * count;
+
+    for (size_t threads = 1;; threads *= 2) {
+        threads = std::min(threads, maxThreads);
+        StaticThreadPool pool(threads);
+
+        void* unalignedRaw = allocatePages(unalignedBytes, policy);
+        if (unalignedRaw == nullptr) return;
+        auto* unalignedArr = reinterpret_cast<UnalignedStruct*>(static_cast<char*>(unalignedRaw) + MISALIGN_OFFSET);
+        double unalignedBw = benchmarkParallelAccess(pool, unalignedArr, count, "❌ Unaligned");
+        freePages(unalignedRaw, unalignedBytes, policy);
+
+        void* alignedRaw = allocatePages(alignedBytes, policy);
+        if (alignedRaw == nullptr) return;
+        double alignedBw = benchmarkParallelAccess(pool, static_cast<AlignedStruct*>(alignedRaw), count, "✅ Aligned");
+        freePages(alignedRaw, alignedBytes, policy);
+
+        std::cout << "   → misalignment costs " << (1.0 - unalignedBw / alignedBw) * 100.0
+                  << "% of aggregate bandwidth\n";
+        if (threads == maxThreads) break;
+    }
+}
+
+enum class AccessPattern { Sequential, Strided, Gather };
 
+const char* accessPatternName(AccessPattern pattern) {
+    switch (pattern) {
+        case AccessPattern::Sequential: return "sequential";
+        case AccessPattern::Strided:    return "strided";
+        case AccessPattern::Gather:     return "gather";
+    }
+    return "?";
+}
+
+// Visit order over the first `count` records. MAX_PREFETCH_DISTANCE entries are
+// appended (wrapping around) so the prefetch index never needs a modulo.
+std::vector<uint32_t> buildAccessOrder(AccessPattern pattern, size_t count) {
+    std::vector<uint32_t> order;
+    order.reserve(count + MAX_PREFETCH_DISTANCE);
+
+    if (pattern == AccessPattern::Strided) {
+        for (size_t offset = 0; offset < PREFETCH_STRIDE; ++offset)
+            for (size_t i = offset; i < count; i += PREFETCH_STRIDE)
+                order.push_back(static_cast<uint32_t>(i));
+    } else {
+        order.resize(count);
+        std::iota(order.begin(), order.end(), 0u);
+        if (pattern == AccessPattern::Gather) {
+            std::mt19937 rng(42);
+            std::shuffle(order.begin(), order.end(), rng);
+        }
+    }
+
+    for (size_t i = 0; i < MAX_PREFETCH_DISTANCE; ++i) order.push_back(order[i % count]);
+    return order;
+}
+
+// Nanoseconds per record for one (distance, hint) setting. Locality is the
+// __builtin_prefetch hint: 3 = T0, 2 = T1, 1 = T2, 0 = NTA.
+template<int Locality, typename T>
+double timePrefetchedWalk(const T* arr, const std::vector<uint32_t>& order, size_t count, size_t distance) {
+    long long sum = 0;
+    size_t passes = std::max<size_t>(1, PREFETCH_ACCESSES / count);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (size_t i = 0; i < count; ++i) {
+            if (distance != 0) __builtin_prefetch(&arr[order[i + distance]], 0, Locality);
+            const T& record = arr[order[i]];
+            for (int j = 0; j < 16; ++j) {
+                sum += record.data[j];
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    asm volatile("" : : "r"(sum)); // keep the loads without a store per record
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / double(passes * count);
+}
+
+template<typename T>
+double timePrefetchedWalk(const T* arr, const std::vector<uint32_t>& order, size_t count,
+                          size_t distance, int hint) {
+    switch (hint) {
+        case 3:  return timePrefetchedWalk<3>(arr, order, count, distance);
+        case 2:  return timePrefetchedWalk<2>(arr, order, count, distance);
+        case 1:  return timePrefetchedWalk<1>(arr, order, count, distance);
+        default: return timePrefetchedWalk<0>(arr, order, count, distance);
+    }
+}
 
-    UnalignedStruct* unalignedArr = new UnalignedStruct[NUM_STRUCTS];
+const char* prefetchHintName(int hint) {
+    switch (hint) {
+        case 3:  return "T0";
+        case 2:  return "T1";
+        case 1:  return "T2";
+        default: return "NTA";
+    }
+}
+
+// Median of PREFETCH_CONFIRM_RUNS timings, alternating baseline and candidate
+// so drift hits both equally.
+template<typename T>
+std::pair<double, double> confirmPrefetch(const T* arr, const std::vector<uint32_t>& order, size_t count,
+                                          size_t distance, int hint) {
+    std::vector<double> baseline, prefetched;
+    for (size_t run = 0; run < PREFETCH_CONFIRM_RUNS; ++run) {
+        baseline.push_back(timePrefetchedWalk<3>(arr, order, count, 0));
+        prefetched.push_back(timePrefetchedWalk(arr, order, count, distance, hint));
+    }
+    auto median = [](std::vector<double>& v) {
+        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+        return v[v.size() / 2];
+    };
+    return {median(baseline), median(prefetched)};
+}
+
+// The sweep only picks a candidate: a min over 28 single shots against one
+// baseline shot would favour prefetching by chance. The reported numbers
+// come from confirmPrefetch().
+template<typename T>
+void sweepPrefetch(const T* arr, const std::vector<uint32_t>& order, size_t count, const std::string& label) {
+    const size_t distances[] = {1, 2, 4, 8, 16, 32, 64};
+    const int hints[] = {3, 2, 1, 0};
+
+    double best = timePrefetchedWalk<3>(arr, order, count, 0);
+    size_t bestDistance = 0;
+    int bestHint = 3;
+
+    for (size_t distance : distances) {
+        for (int hint : hints) {
+            double ns = timePrefetchedWalk(arr, order, count, distance, hint);
+            if (ns < best) {
+                best = ns;
+                bestDistance = distance;
+                bestHint = hint;
+            }
+        }
+    }
+
+    auto [baseline, prefetched] = confirmPrefetch(arr, order, count, bestDistance, bestHint);
+    std::cout << "    " << label << ": no prefetch " << baseline << " ns/rec, best ";
+    if (bestDistance == 0 || prefetched >= baseline) {
+        std::cout << "is no prefetch\n";
+    } else {
+        std::cout << "distance " << bestDistance << " " << prefetchHintName(bestHint) << " → " << prefetched
+                  << " ns/rec (" << (1.0 - prefetched / baseline) * 100.0 << "% faster)\n";
+    }
+}
+
+void runPrefetchMode(const UnalignedStruct* unalignedArr, const AlignedStruct* alignedArr) {
+    std::cout << "\n🎯 Prefetch distance sweep (distance 0-" << MAX_PREFETCH_DISTANCE << ", hints T0/T1/T2/NTA)\n";
+
+    const size_t workingSets[] = {32 * 1024, 1024 * 1024, 16 * 1024 * 1024, NUM_STRUCTS * sizeof(AlignedStruct)};
+    const AccessPattern patterns[] = {AccessPattern::Sequential, AccessPattern::Strided, AccessPattern::Gather};
+
+    for (AccessPattern pattern : patterns) {
+        for (size_t bytes : workingSets) {
+            size_t count = std::min(NUM_STRUCTS, bytes / sizeof(AlignedStruct));
+            std::vector<uint32_t> order = buildAccessOrder(pattern, count);
+
+            std::cout << "  " << accessPatternName(pattern) << ", " << bytes / 1024 << " KB working set:\n";
+            sweepPrefetch(unalignedArr, order, count, "❌ Unaligned");
+            sweepPrefetch(alignedArr, order, count, "✅ Aligned");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    PagePolicy policy;
+    try {
+        policy = parsePagePolicy(options.get("pages", "4k"));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "🔍 Testing cache line alignment impact (" << pagePolicyName(policy) << ")...\n";
+
+    // Parallel mode sizes and places its own arrays, so dispatch it before
+    // the single-thread ones are mapped and touched.
+    std::string mode = options.get("mode", "single");
+    if (mode == "parallel") {
+        runParallelMode(policy, std::max<size_t>(1, options.getSize("threads", cpuCount())));
+        return 0;
+    }
+
+    // Page-backed memory always starts on a boundary, so shift the unaligned
+    // array by MISALIGN_OFFSET to keep every struct straddling two lines.
+    size_t unalignedBytes = sizeof(UnalignedStruct) * NUM_STRUCTS + MISALIGN_OFFSET;
+    void* unalignedRaw = allocatePages(unalignedBytes, policy);
+    if (unalignedRaw == nullptr) return 1;
+    UnalignedStruct* unalignedArr = reinterpret_cast<UnalignedStruct*>(
+        static_cast<char*>(unalignedRaw) + MISALIGN_OFFSET);
     std::memset(unalignedArr, 0, sizeof(UnalignedStruct) * NUM_STRUCTS);
 
 
-    void* rawPtr = std::aligned_alloc(CACHE_LINE_SIZE, sizeof(AlignedStruct) * NUM_STRUCTS);
-    assert(rawPtr != nullptr && "aligned_alloc failed");
-    AlignedStruct* alignedArr = reinterpret_cast<AlignedStruct*>(rawPtr);
-    std::memset(alignedArr, 0, sizeof(AlignedStruct) * NUM_STRUCTS);
+    // Raw path, kept only as the zero-overhead reference for aligned_array.
+    size_t alignedBytes = sizeof(AlignedStruct) * NUM_STRUCTS;
+    void* rawPtr = allocatePages(alignedBytes, policy);
+    if (rawPtr == nullptr) return 1;
+    assert(reinterpret_cast<uintptr_t>(rawPtr) % CACHE_LINE_SIZE == 0);
+    AlignedStruct* rawAlignedArr = reinterpret_cast<AlignedStruct*>(rawPtr);
+    std::memset(rawAlignedArr, 0, alignedBytes);
 
-  
-    auto unalignedTime = benchmarkAccess(unalignedArr, NUM_STRUCTS, "❌ Unaligned access");
-    auto alignedTime = benchmarkAccess(alignedArr, NUM_STRUCTS, "✅ Aligned access");
+    try {
+        aligned_array<AlignedStruct, CACHE_LINE_SIZE> alignedArr(NUM_STRUCTS, policy);
+
+        if (mode == "prefetch") {
+            runPrefetchMode(unalignedArr, alignedArr.data());
+        } else {
+            auto unalignedTime = benchmarkAccess(unalignedArr, NUM_STRUCTS, "❌ Unaligned access");
+            auto rawAlignedTime = benchmarkAccess(rawAlignedArr, NUM_STRUCTS, "✅ Aligned access (raw)");
+            auto alignedTime = benchmarkContainerAccess(alignedArr, "✅ Aligned access (aligned_array)");
+            std::cout << "   → aligned_array vs raw: " << alignedTime - rawAlignedTime << " ms\n";
+        }
+    } catch (const std::bad_alloc&) {
+        std::cerr << "aligned_array allocation failed\n";
+        return 1;
+    }
 
-    delete[] unalignedArr;
-    std::free(alignedArr);
+    freePages(unalignedRaw, unalignedBytes, policy);
+    freePages(rawPtr, alignedBytes, policy);
 
     return 0;
 }
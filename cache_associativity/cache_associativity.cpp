@@ -0,0 +1,256 @@
+// -----------------------------------------------------------
+// PROBLEM – CACHE ASSOCIATIVITY & SET CONFLICTS
+// -----------------------------------------------------------
+
+// 1. WHAT IS THE PROBLEM?
+/*
+   A cache is not one big bucket. It is split into SETS, and every
+   address can only live in one set, chosen by a few address bits:
+
+       set = (address / line_size) % number_of_sets
+
+   Each set holds only WAYS lines (e.g. 12 for a 48K L1D).
+   If more than WAYS hot lines map to the same set, they evict each
+   other even though the rest of the cache is empty – a CONFLICT miss.
+*/
+
+// 2. WHEN DOES THIS HAPPEN?
+/*
+   When data is accessed at a power-of-two stride.
+   The CRITICAL STRIDE is number_of_sets * line_size (4096 bytes for a
+   typical L1D): every element spaced by it lands in the same set.
+
+   Classic victims:
+   - ring buffers / per-thread slots sized at 4K or 64K
+   - matrix columns with a power-of-two row length
+   - arrays of page-aligned structs
+*/
+
+// 3. HOW DO WE FIX IT?
+/*
+   Break the power-of-two pattern:
+   - PADDING: stride + one cache line, so consecutive elements walk across sets
+   - SKEWING: keep the stride but offset element i by a different number
+     of lines, spreading the elements over many sets
+*/
+
+// 4. HOW DO WE TEST IT?
+/*
+   - Read the real L1/L2 geometry from /sys/devices/system/cpu/cpu0/cache
+   - Chase pointers through K lines spaced STRIDE bytes apart, with K larger
+     than the associativity but far smaller than the cache capacity
+   - At harmless strides everything hits L1; at the critical stride the
+     time per access jumps to the next cache level
+   - Then rerun the critical strides with padding and skewing
+
+   L1 is virtually indexed, so 4K-stride conflicts show up anywhere.
+   L2 uses physical address bits above the 4K page offset – run with
+   --pages=thp or --pages=2m to make the 64K / L2-critical results stable.
+*/
+
+
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <charconv>
+
+#include "bench_options.hpp"
+#include "huge_pages.hpp"
+#include "perf_counters.hpp"
+
+constexpr size_t NUM_ACCESSES = 20'000'000;
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t SKEW_MULTIPLIER = 7; // odd, so skews cycle through every set
+
+struct CacheLevel {
+    int level = 0;
+    std::string type;
+    size_t ways = 0;
+    size_t sets = 0;
+    size_t lineSize = CACHE_LINE_SIZE;
+    size_t sizeBytes = 0;
+
+    size_t criticalStride() const { return sets * lineSize; }
+};
+
+std::string readCacheAttribute(const std::string& dir, const std::string& name) {
+    std::ifstream in(dir + "/" + name);
+    std::string value;
+    in >> value;
+    return value;
+}
+
+// 0 when the attribute is missing, empty or not a number (some VMs leave
+// ways_of_associativity blank), so the caller can skip that level.
+size_t readCacheSize(const std::string& dir, const std::string& name) {
+    std::string value = readCacheAttribute(dir, name);
+    size_t parsed = 0;
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+    if (error != std::errc() || end != value.data() + value.size()) return 0;
+    return parsed;
+}
+
+// Returns the data/unified caches of cpu0 (L1D, L2, L3...), empty if sysfs is
+// missing. Levels with unreadable geometry are left out.
+std::vector<CacheLevel> detectCaches() {
+    std::vector<CacheLevel> caches;
+    for (int index = 0;; ++index) {
+        std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index);
+        std::string level = readCacheAttribute(dir, "level");
+        if (level.empty()) break;
+
+        CacheLevel cache;
+        cache.level = static_cast<int>(readCacheSize(dir, "level"));
+        cache.type = readCacheAttribute(dir, "type");
+        if (cache.type == "Instruction") continue;
+
+        cache.ways = readCacheSize(dir, "ways_of_associativity");
+        cache.sets = readCacheSize(dir, "number_of_sets");
+        cache.lineSize = readCacheSize(dir, "coherency_line_size");
+        if (cache.level == 0 || cache.ways == 0 || cache.sets == 0 || cache.lineSize == 0) continue;
+        cache.sizeBytes = cache.ways * cache.sets * cache.lineSize;
+        caches.push_back(cache);
+    }
+    return caches;
+}
+
+// Fallback when sysfs is unavailable: a common 48K 12-way L1D, 2M 16-way L2.
+std::vector<CacheLevel> defaultCaches() {
+    return {
+        {1, "Data", 12, 64, CACHE_LINE_SIZE, 48 * 1024},
+        {2, "Unified", 16, 2048, CACHE_LINE_SIZE, 2 * 1024 * 1024},
+    };
+}
+
+// Byte offset of element i for a given layout.
+enum class Placement { Plain, Padded, Skewed };
+
+size_t elementOffset(size_t i, size_t stride, Placement placement, size_t sets) {
+    switch (placement) {
+        case Placement::Plain:  return i * stride;
+        case Placement::Padded: return i * (stride + CACHE_LINE_SIZE);
+        case Placement::Skewed: return i * stride + (i * SKEW_MULTIPLIER % sets) * CACHE_LINE_SIZE;
+    }
+    return i * stride;
+}
+
+// Links `lines` slots into a cyclic pointer chain and walks it NUM_ACCESSES times.
+// Each load depends on the previous one, so the time per access is the latency
+// of whichever cache level the chain fits in.
+double chaseStride(size_t stride, size_t lines, Placement placement, size_t sets,
+                   PagePolicy policy, long long& l1Misses) {
+    size_t bytes = elementOffset(lines, stride, placement, sets) + CACHE_LINE_SIZE;
+    void* memory = allocatePages(bytes, policy);
+    if (memory == nullptr) return -1.0;
+    char* base = static_cast<char*>(memory);
+
+    for (size_t i = 0; i < lines; ++i) {
+        void** slot = reinterpret_cast<void**>(base + elementOffset(i, stride, placement, sets));
+        *slot = base + elementOffset((i + 1) % lines, stride, placement, sets);
+    }
+
+    PerfCounter l1dMisses(PerfEvent::L1dLoadMisses);
+    void* p = base;
+
+    l1dMisses.start();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < NUM_ACCESSES; ++i) {
+        p = *static_cast<void**>(p);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    l1Misses = l1dMisses.stop();
+    asm volatile("" : : "r"(p)); // keep the chain live without a store per access
+
+    freePages(memory, bytes, policy);
+    return std::chrono::duration<double, std::nano>(end - start).count() / NUM_ACCESSES;
+}
+
+void printRow(const std::string& label, double ns, long long misses) {
+    std::cout << "  " << label;
+    for (size_t pad = label.size(); pad < 28; ++pad) std::cout << ' ';
+    std::cout << ns << " ns/access, L1D misses: " << formatCount(misses) << "\n";
+}
+
+void runStrideSweep(const CacheLevel& l1, const CacheLevel& l2, size_t lines, PagePolicy policy) {
+    std::cout << "\n📏 Stride sweep (" << lines << " lines per chain):\n";
+
+    std::vector<size_t> strides = {64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 65536,
+                                   l1.criticalStride(), l2.criticalStride()};
+    std::sort(strides.begin(), strides.end());
+    strides.erase(std::unique(strides.begin(), strides.end()), strides.end());
+
+    for (size_t stride : strides) {
+        long long misses = 0;
+        double ns = chaseStride(stride, lines, Placement::Plain, l1.sets, policy, misses);
+        std::string label = std::to_string(stride) + " B";
+        if (stride == l1.criticalStride()) label += " (L1 critical)";
+        if (stride == l2.criticalStride()) label += " (L2 critical)";
+        printRow(label, ns, misses);
+    }
+}
+
+void runWaysSweep(const CacheLevel& l1, PagePolicy policy) {
+    std::cout << "\n🧮 Lines in one L1 set at the critical stride (" << l1.criticalStride() << " B):\n";
+
+    for (size_t lines = l1.ways > 2 ? l1.ways - 2 : 1; lines <= l1.ways + 4; ++lines) {
+        long long misses = 0;
+        double ns = chaseStride(l1.criticalStride(), lines, Placement::Plain, l1.sets, policy, misses);
+        std::string label = std::to_string(lines) + " lines" + (lines > l1.ways ? " ❌" : " ✅");
+        printRow(label, ns, misses);
+    }
+}
+
+void runFixes(const CacheLevel& l1, const CacheLevel& l2, size_t lines, PagePolicy policy) {
+    std::cout << "\n🔧 Padding / skewing at the conflicting strides:\n";
+
+    for (size_t stride : {l1.criticalStride(), size_t{65536}, l2.criticalStride()}) {
+        std::string s = std::to_string(stride) + " B";
+        long long misses = 0;
+        double ns = 0.0;
+
+        ns = chaseStride(stride, lines, Placement::Plain, l1.sets, policy, misses);
+        printRow("❌ " + s + " plain", ns, misses);
+        ns = chaseStride(stride, lines, Placement::Padded, l1.sets, policy, misses);
+        printRow("✅ " + s + " +64 padded", ns, misses);
+        ns = chaseStride(stride, lines, Placement::Skewed, l1.sets, policy, misses);
+        printRow("✅ " + s + " skewed", ns, misses);
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    PagePolicy policy;
+    try {
+        policy = parsePagePolicy(options.get("pages", "4k"));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::vector<CacheLevel> caches = detectCaches();
+    if (caches.size() < 2 || caches[0].level != 1 || caches[1].level != 2) {
+        std::cerr << "Could not read cache geometry from sysfs, assuming 48K/12-way L1D and 2M/16-way L2.\n";
+        caches = defaultCaches();
+    }
+    const CacheLevel& l1 = caches[0];
+    const CacheLevel& l2 = caches[1];
+
+    std::cout << "🔍 Cache associativity benchmark (" << pagePolicyName(policy) << ")\n";
+    for (const CacheLevel& cache : caches) {
+        std::cout << "  L" << cache.level << " " << cache.type << ": " << cache.sizeBytes / 1024 << " KB, "
+                  << cache.ways << "-way, " << cache.sets << " sets, critical stride "
+                  << cache.criticalStride() << " B\n";
+    }
+
+    // More lines than either level's associativity, far fewer than L1 capacity.
+    size_t lines = std::max<size_t>(2, options.getSize("lines", 2 * std::max(l1.ways, l2.ways)));
+
+    runStrideSweep(l1, l2, lines, policy);
+    runWaysSweep(l1, policy);
+    runFixes(l1, l2, lines, policy);
+    return 0;
+}
@@ -0,0 +1,123 @@
+// ---------------------------------------------
+// SHARED – aligned_array<T, Align>
+// ---------------------------------------------
+
+/*
+   A fixed-size, heap-allocated array whose storage starts on an Align
+   boundary (a cache line by default). It replaces the
+   aligned_alloc + reinterpret_cast + memset pattern with something that
+   actually constructs and destroys its elements.
+
+   - Compile-time checks that Align is usable for T and that elements
+     tile Align blocks cleanly (no element straddles a boundary).
+   - Elements are value-initialised, so PODs start zeroed like memset did.
+   - Pass a PagePolicy to back the storage with (huge) pages instead of
+     aligned_alloc; page-backed storage is always at least 4K aligned.
+   - Access is a raw pointer underneath, so loops compile to the same
+     code as the hand-rolled version.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "huge_pages.hpp"
+
+template<typename T, size_t Align = 64>
+class aligned_array {
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "Align must be a power of two");
+    static_assert(Align >= alignof(T), "Align is weaker than alignof(T)");
+    static_assert(sizeof(T) % Align == 0 || Align % sizeof(T) == 0,
+                  "elements of T would straddle Align boundaries – pad T or pick another Align");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    explicit aligned_array(size_t count) : size_(count) {
+        bytes_ = (count * sizeof(T) + Align - 1) / Align * Align;
+        data_ = static_cast<T*>(std::aligned_alloc(Align, bytes_));
+        if (data_ == nullptr) throw std::bad_alloc();
+        construct();
+    }
+
+    aligned_array(size_t count, PagePolicy policy)
+        : size_(count), bytes_(count * sizeof(T)), pageBacked_(true), policy_(policy) {
+        static_assert(Align <= SMALL_PAGE_SIZE, "page-backed storage is only page aligned");
+        data_ = static_cast<T*>(allocatePages(bytes_, policy_));
+        if (data_ == nullptr) throw std::bad_alloc();
+        construct();
+    }
+
+    ~aligned_array() {
+        if (data_ == nullptr) return;
+        std::destroy_n(data_, size_);
+        release();
+    }
+
+    aligned_array(const aligned_array&) = delete;
+    aligned_array& operator=(const aligned_array&) = delete;
+
+    aligned_array(aligned_array&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          bytes_(std::exchange(other.bytes_, 0)),
+          pageBacked_(other.pageBacked_),
+          policy_(other.policy_) {}
+
+    aligned_array& operator=(aligned_array&& other) noexcept {
+        aligned_array moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    void swap(aligned_array& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(bytes_, other.bytes_);
+        std::swap(pageBacked_, other.pageBacked_);
+        std::swap(policy_, other.policy_);
+    }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+private:
+    void construct() {
+        try {
+            std::uninitialized_value_construct_n(data_, size_);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    void release() {
+        if (pageBacked_) {
+            freePages(data_, bytes_, policy_);
+        } else {
+            std::free(data_);
+        }
+        data_ = nullptr;
+    }
+
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t bytes_ = 0;
+    bool pageBacked_ = false;
+    PagePolicy policy_ = PagePolicy::Small4K;
+};
@@ -0,0 +1,52 @@
+// ---------------------------------------------
+// SHARED – COMMAND LINE OPTIONS
+// ---------------------------------------------
+
+/*
+   Every module takes its knobs as --key=value flags (or a bare --key),
+   e.g. ./cache_alignment --pages=thp
+
+   Anything not given falls back to the module's built-in default,
+   so running a module with no arguments behaves exactly as before.
+*/
+
+#pragma once
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+class BenchOptions {
+public:
+    BenchOptions(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) continue;
+
+            auto eq = arg.find('=');
+            if (eq == std::string::npos) {
+                values_[arg.substr(2)] = "";
+            } else {
+                values_[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+            }
+        }
+    }
+
+    bool has(const std::string& key) const {
+        return values_.count(key) != 0;
+    }
+
+    std::string get(const std::string& key, const std::string& fallback) const {
+        auto it = values_.find(key);
+        return it == values_.end() ? fallback : it->second;
+    }
+
+    size_t getSize(const std::string& key, size_t fallback) const {
+        auto it = values_.find(key);
+        if (it == values_.end() || it->second.empty()) return fallback;
+        return static_cast<size_t>(std::strtoull(it->second.c_str(), nullptr, 10));
+    }
+
+private:
+    std::map<std::string, std::string> values_;
+};
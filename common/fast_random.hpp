@@ -0,0 +1,34 @@
+// ---------------------------------------------
+// SHARED – FAST RANDOM
+// ---------------------------------------------
+
+/*
+   xorshift64: a few shifts and xors per draw, so generating random data or
+   random choices inside a timed loop costs next to nothing and the same
+   for every layout or allocator being compared. Not for statistics –
+   below() has a slight modulo bias, which no benchmark here cares about.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct FastRandom {
+    uint64_t state;
+
+    explicit FastRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Uniform-ish in [0, n).
+    size_t below(size_t n) { return next() % n; }
+
+    // Uniform in [0, 1), 24 bits of mantissa.
+    float unit() { return static_cast<float>(next() >> 40) / static_cast<float>(1 << 24); }
+};
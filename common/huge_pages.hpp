@@ -0,0 +1,214 @@
+// ---------------------------------------------
+// SHARED – PAGE SIZE POLICY (4K / THP / 2M / 1G)
+// ---------------------------------------------
+
+// 1. WHAT IS THE PROBLEM?
+/*
+   Every virtual address has to be translated through the TLB.
+   With 4K pages a 1 GB working set needs 262,144 translations,
+   far more than any dTLB holds, so a linear scan keeps missing
+   the TLB and walking page tables on top of its cache misses.
+*/
+
+// 2. HOW DO WE FIX IT?
+/*
+   Back the big arrays with larger pages:
+   - thp : normal mmap + madvise(MADV_HUGEPAGE), kernel promotes to 2M when it can
+   - 2m  : explicit MAP_HUGETLB 2M pages (needs vm.nr_hugepages reserved)
+   - 1g  : explicit MAP_HUGETLB 1G pages (needs 1G pages reserved at boot)
+
+   The same allocation path is used by cache_alignment, soa_vs_aos and
+   heap_vs_pool, selected with --pages=4k|thp|2m|1g.
+*/
+
+#pragma once
+
+#include <sys/mman.h>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
+enum class PagePolicy {
+    Small4K,
+    TransparentHuge,
+    Huge2M,
+    Huge1G,
+};
+
+constexpr size_t SMALL_PAGE_SIZE = 4096;
+constexpr size_t HUGE_PAGE_2M = 2 * 1024 * 1024;
+constexpr size_t HUGE_PAGE_1G = 1024 * 1024 * 1024;
+
+inline PagePolicy parsePagePolicy(const std::string& name) {
+    if (name == "4k") return PagePolicy::Small4K;
+    if (name == "thp") return PagePolicy::TransparentHuge;
+    if (name == "2m") return PagePolicy::Huge2M;
+    if (name == "1g") return PagePolicy::Huge1G;
+    throw std::invalid_argument("unknown page policy '" + name + "' (expected 4k, thp, 2m or 1g)");
+}
+
+inline const char* pagePolicyName(PagePolicy policy) {
+    switch (policy) {
+        case PagePolicy::Small4K:         return "4K pages";
+        case PagePolicy::TransparentHuge: return "THP (madvise)";
+        case PagePolicy::Huge2M:          return "MAP_HUGETLB 2M";
+        case PagePolicy::Huge1G:          return "MAP_HUGETLB 1G";
+    }
+    return "?";
+}
+
+inline size_t pageSizeFor(PagePolicy policy) {
+    switch (policy) {
+        case PagePolicy::Small4K:         return SMALL_PAGE_SIZE;
+        case PagePolicy::TransparentHuge: return HUGE_PAGE_2M;
+        case PagePolicy::Huge2M:          return HUGE_PAGE_2M;
+        case PagePolicy::Huge1G:          return HUGE_PAGE_1G;
+    }
+    return SMALL_PAGE_SIZE;
+}
+
+inline size_t roundUpToPage(size_t bytes, PagePolicy policy) {
+    size_t page = pageSizeFor(policy);
+    return (bytes + page - 1) / page * page;
+}
+
+// Returns page-aligned, zero-filled, not-yet-faulted memory, or nullptr on failure.
+inline void* allocatePages(size_t bytes, PagePolicy policy) {
+    size_t length = roundUpToPage(bytes, policy);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (policy == PagePolicy::Huge2M || policy == PagePolicy::Huge1G) {
+        flags |= MAP_HUGETLB | (policy == PagePolicy::Huge2M ? MAP_HUGE_2MB : MAP_HUGE_1GB);
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "mmap(" << pagePolicyName(policy) << ") failed – are hugepages reserved? "
+                      << "(see /proc/sys/vm/nr_hugepages)\n";
+            return nullptr;
+        }
+        return p;
+    }
+
+    if (policy == PagePolicy::Small4K) {
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    // THP: the kernel only promotes 2M-aligned ranges, so over-map and trim.
+    size_t padded = length + HUGE_PAGE_2M;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    auto base = reinterpret_cast<uintptr_t>(raw);
+    auto aligned = (base + HUGE_PAGE_2M - 1) & ~(uintptr_t(HUGE_PAGE_2M) - 1);
+    size_t head = aligned - base;
+    size_t tail = padded - head - length;
+    if (head) munmap(raw, head);
+    if (tail) munmap(reinterpret_cast<void*>(aligned + length), tail);
+
+    madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void freePages(void* p, size_t bytes, PagePolicy policy) {
+    if (p) munmap(p, roundUpToPage(bytes, policy));
+}
+
+// Faults in every page of a mapping now (and pins it with mlock if `lock`),
+// so first-touch faults happen at startup instead of on the hot path – the
+// effect of MAP_POPULATE on memory that is already mapped. Contents are kept.
+// Returns false if mlock was refused (usually RLIMIT_MEMLOCK); the pages are
+// faulted in either way.
+inline bool prefaultPages(void* p, size_t bytes, PagePolicy policy, bool lock = false) {
+    if (p == nullptr) return false;
+    size_t length = roundUpToPage(bytes, policy);
+    bool populated = false;
+#ifdef MADV_POPULATE_WRITE
+    populated = madvise(p, length, MADV_POPULATE_WRITE) == 0;
+#endif
+    if (!populated) {
+        volatile unsigned char* bytesOf = static_cast<unsigned char*>(p);
+        for (size_t offset = 0; offset < length; offset += SMALL_PAGE_SIZE) bytesOf[offset] = bytesOf[offset];
+    }
+    return !lock || mlock(p, length) == 0;
+}
+
+// std-compatible allocator so containers (std::vector etc.) can use a page policy.
+template<typename T>
+struct PageAllocator {
+    using value_type = T;
+
+    PagePolicy policy = PagePolicy::Small4K;
+
+    PageAllocator() = default;
+    explicit PageAllocator(PagePolicy p) : policy(p) {}
+    template<typename U>
+    PageAllocator(const PageAllocator<U>& other) : policy(other.policy) {}
+
+    T* allocate(size_t n) {
+        void* p = allocatePages(n * sizeof(T), policy);
+        if (!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) {
+        freePages(p, n * sizeof(T), policy);
+    }
+
+    template<typename U>
+    bool operator==(const PageAllocator<U>& other) const { return policy == other.policy; }
+    template<typename U>
+    bool operator!=(const PageAllocator<U>& other) const { return policy != other.policy; }
+};
+
+template<typename T>
+using PageVector = std::vector<T, PageAllocator<T>>;
+
+// Page-backed array that is NOT written on allocation: each page is faulted in
+// (and, on NUMA machines, placed) by whichever thread first writes to it.
+// Fresh pages read as zero. Only for trivially copyable T.
+template<typename T>
+class PageArray {
+    static_assert(std::is_trivially_copyable_v<T>, "PageArray never runs constructors");
+
+public:
+    PageArray(size_t count, PagePolicy policy) : size_(count), policy_(policy) {
+        data_ = static_cast<T*>(allocatePages(count * sizeof(T), policy));
+        if (data_ == nullptr) throw std::bad_alloc();
+    }
+
+    ~PageArray() { freePages(data_, size_ * sizeof(T), policy_); }
+
+    PageArray(const PageArray&) = delete;
+    PageArray& operator=(const PageArray&) = delete;
+
+    PageArray(PageArray&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)), policy_(other.policy_) {}
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    PagePolicy policy_;
+};
@@ -0,0 +1,95 @@
+// ---------------------------------------------
+// SHARED – HARDWARE PERFORMANCE COUNTERS
+// ---------------------------------------------
+
+/*
+   Thin wrapper around perf_event_open so a benchmark can report
+   *why* it was slow (TLB misses, cache misses), not just how long it took.
+
+   Counters are per-thread, user-space only. Inside VMs/containers or with
+   a strict kernel.perf_event_paranoid the syscall fails – the counter then
+   reports -1 and formatCount() prints "n/a" instead of aborting the run.
+*/
+
+#pragma once
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+enum class PerfEvent {
+    DtlbLoadMisses,
+    L1dLoadMisses,
+    LlcLoadMisses,
+    CacheMisses,
+};
+
+class PerfCounter {
+public:
+    explicit PerfCounter(PerfEvent event) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        constexpr uint64_t readMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        switch (event) {
+            case PerfEvent::DtlbLoadMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_DTLB | readMiss;
+                break;
+            case PerfEvent::L1dLoadMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | readMiss;
+                break;
+            case PerfEvent::LlcLoadMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL | readMiss;
+                break;
+            case PerfEvent::CacheMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+        }
+
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~PerfCounter() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    bool available() const { return fd_ >= 0; }
+
+    void start() {
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    // Returns the count since start(), or -1 if the counter is unavailable.
+    long long stop() {
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (read(fd_, &value, sizeof(value)) != sizeof(value)) return -1;
+        return value;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+inline std::string formatCount(long long count) {
+    return count < 0 ? "n/a" : std::to_string(count);
+}
@@ -0,0 +1,281 @@
+// ---------------------------------------------
+// SHARED – soa_vector<Fields...>
+// ---------------------------------------------
+
+/*
+   A growable Struct-of-Arrays container, so new record types don't need
+   a hand-written set of parallel std::vectors.
+
+   Fields are tag types that name a column and its element type:
+
+       struct PosX : soa_field<float> {};
+       struct PosY : soa_field<float> {};
+       soa_vector<PosX, PosY> points;
+
+       points.push_back(1.0f, 2.0f);
+       for (float x : points.column<PosX>()) ...        // one contiguous column
+       for (auto [x, y] : points) x += y;               // AoS-style, by reference
+       Point p = points[0].as<Point>();                 // copy out as a record
+
+   - All columns live in ONE page-backed allocation (optionally huge pages),
+     each column starting on its own cache line.
+   - Elements must be trivially copyable – growth moves columns with memcpy.
+   - operator[] / iteration hand out a small proxy (vector pointer + index)
+     that resolves get<Field>() to columns[field][index].
+
+   Rows don't have ParticleAoS-style `.x` members: C++ can't generate named
+   members from a tag pack, so the field tag is the name – row.get<PosX>(),
+   a structured binding, or as<Record>() for a real struct. Because *it
+   returns that proxy by value, the iterators are input iterators: fine for
+   range-for and single-pass algorithms, not for ones needing T&.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "huge_pages.hpp"
+
+template<typename T>
+struct soa_field {
+    using type = T;
+};
+
+namespace soa_detail {
+
+template<typename F, typename... Fs>
+struct index_of;
+
+template<typename F, typename... Fs>
+struct index_of<F, F, Fs...> : std::integral_constant<size_t, 0> {};
+
+template<typename F, typename G, typename... Fs>
+struct index_of<F, G, Fs...> : std::integral_constant<size_t, 1 + index_of<F, Fs...>::value> {};
+
+constexpr size_t COLUMN_ALIGN = 64;
+
+constexpr size_t alignColumn(size_t bytes) {
+    return (bytes + COLUMN_ALIGN - 1) / COLUMN_ALIGN * COLUMN_ALIGN;
+}
+
+} // namespace soa_detail
+
+// Proxy for one element: a pointer to the container plus an index.
+// Owner is soa_vector<...> or const soa_vector<...>.
+template<typename Owner>
+class soa_reference {
+public:
+    soa_reference(Owner* v, size_t i) : v_(v), i_(i) {}
+
+    template<typename F>
+    auto& get() const {
+        return v_->template columnAt<std::remove_const_t<Owner>::template field_index<F>>()[i_];
+    }
+
+    template<size_t I>
+    auto& get() const { return v_->template columnAt<I>()[i_]; }
+
+    // Copies the element out as an aggregate whose members follow field order.
+    template<typename Record>
+    Record as() const { return v_->template recordAt<Record>(i_); }
+
+private:
+    Owner* v_;
+    size_t i_;
+};
+
+template<typename... Fields>
+class soa_vector {
+    static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+    static_assert((std::is_trivially_copyable_v<typename Fields::type> && ...),
+                  "soa_vector columns must be trivially copyable");
+
+public:
+    static constexpr size_t NUM_FIELDS = sizeof...(Fields);
+
+    template<size_t I>
+    using field_type = typename std::tuple_element_t<I, std::tuple<Fields...>>::type;
+
+    template<typename F>
+    static constexpr size_t field_index = soa_detail::index_of<F, Fields...>::value;
+
+    using reference = soa_reference<soa_vector>;
+    using const_reference = soa_reference<const soa_vector>;
+
+    template<bool Const>
+    class basic_iterator {
+        using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = soa_reference<owner>;
+        using reference = soa_reference<owner>;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+
+        basic_iterator() = default;
+        basic_iterator(owner* v, size_t i) : v_(v), i_(i) {}
+
+        soa_reference<owner> operator*() const { return {v_, i_}; }
+        basic_iterator& operator++() { ++i_; return *this; }
+        basic_iterator operator++(int) { auto old = *this; ++i_; return old; }
+        bool operator==(const basic_iterator& other) const { return i_ == other.i_; }
+
+    private:
+        owner* v_ = nullptr;
+        size_t i_ = 0;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    explicit soa_vector(PagePolicy policy = PagePolicy::Small4K) : policy_(policy) {}
+
+    // Sized constructor: `count` value-initialised elements.
+    soa_vector(size_t count, PagePolicy policy) : policy_(policy) {
+        resize(count);
+    }
+
+    ~soa_vector() { freePages(buffer_, bufferBytes_, policy_); }
+
+    soa_vector(const soa_vector&) = delete;
+    soa_vector& operator=(const soa_vector&) = delete;
+
+    soa_vector(soa_vector&& other) noexcept
+        : policy_(other.policy_),
+          buffer_(std::exchange(other.buffer_, nullptr)),
+          bufferBytes_(std::exchange(other.bufferBytes_, 0)),
+          columns_(std::exchange(other.columns_, {})),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    soa_vector& operator=(soa_vector&& other) noexcept {
+        soa_vector moved(std::move(other));
+        std::swap(policy_, moved.policy_);
+        std::swap(buffer_, moved.buffer_);
+        std::swap(bufferBytes_, moved.bufferBytes_);
+        std::swap(columns_, moved.columns_);
+        std::swap(size_, moved.size_);
+        std::swap(capacity_, moved.capacity_);
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    void reserve(size_t newCapacity) {
+        if (newCapacity <= capacity_) return;
+
+        size_t bytes = bytesFor(newCapacity);
+        void* buffer = allocatePages(bytes, policy_);
+        if (buffer == nullptr) throw std::bad_alloc();
+
+        std::array<void*, NUM_FIELDS> columns = layout(static_cast<std::byte*>(buffer), newCapacity);
+        copyColumns(columns, std::make_index_sequence<NUM_FIELDS>{});
+
+        freePages(buffer_, bufferBytes_, policy_);
+        buffer_ = buffer;
+        bufferBytes_ = bytes;
+        columns_ = columns;
+        capacity_ = newCapacity;
+    }
+
+    void resize(size_t count) {
+        reserve(count);
+        if (count > size_) initColumns(size_, count, std::make_index_sequence<NUM_FIELDS>{});
+        size_ = count;
+    }
+
+    void clear() { size_ = 0; }
+
+    void push_back(const typename Fields::type&... values) {
+        if (size_ == capacity_) reserve(capacity_ == 0 ? 64 : capacity_ * 2);
+        storeAt(size_, std::make_index_sequence<NUM_FIELDS>{}, values...);
+        ++size_;
+    }
+
+    template<typename F>
+    std::span<typename F::type> column() {
+        return {columnAt<field_index<F>>(), size_};
+    }
+
+    template<typename F>
+    std::span<const typename F::type> column() const {
+        return {columnAt<field_index<F>>(), size_};
+    }
+
+    reference operator[](size_t i) { return {this, i}; }
+    const_reference operator[](size_t i) const { return {this, i}; }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, size_}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+
+    template<size_t I>
+    field_type<I>* columnAt() { return static_cast<field_type<I>*>(columns_[I]); }
+
+    template<size_t I>
+    const field_type<I>* columnAt() const { return static_cast<const field_type<I>*>(columns_[I]); }
+
+    template<typename Record>
+    Record recordAt(size_t i) const { return Record{columnAt<field_index<Fields>>()[i]...}; }
+
+private:
+    static size_t bytesFor(size_t capacity) {
+        return (soa_detail::alignColumn(capacity * sizeof(typename Fields::type)) + ...);
+    }
+
+    static std::array<void*, NUM_FIELDS> layout(std::byte* base, size_t capacity) {
+        std::array<void*, NUM_FIELDS> columns{};
+        size_t offset = 0;
+        size_t i = 0;
+        ((columns[i++] = base + offset,
+          offset += soa_detail::alignColumn(capacity * sizeof(typename Fields::type))), ...);
+        return columns;
+    }
+
+    template<size_t... I>
+    void copyColumns(const std::array<void*, NUM_FIELDS>& to, std::index_sequence<I...>) {
+        if (size_ == 0) return;
+        (std::memcpy(to[I], columns_[I], size_ * sizeof(field_type<I>)), ...);
+    }
+
+    template<size_t... I>
+    void initColumns(size_t from, size_t to, std::index_sequence<I...>) {
+        ((std::fill(columnAt<I>() + from, columnAt<I>() + to, field_type<I>{})), ...);
+    }
+
+    template<size_t... I, typename... Values>
+    void storeAt(size_t i, std::index_sequence<I...>, const Values&... values) {
+        ((columnAt<I>()[i] = values), ...);
+    }
+
+    PagePolicy policy_;
+    void* buffer_ = nullptr;
+    size_t bufferBytes_ = 0;
+    std::array<void*, NUM_FIELDS> columns_{};
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+// Tuple protocol for the proxy, so `auto [x, y, z] = soa[i];` binds references.
+template<typename Owner>
+struct std::tuple_size<soa_reference<Owner>>
+    : std::integral_constant<size_t, std::remove_const_t<Owner>::NUM_FIELDS> {};
+
+template<size_t I, typename Owner>
+struct std::tuple_element<I, soa_reference<Owner>> {
+    using field = typename std::remove_const_t<Owner>::template field_type<I>;
+    using type = std::conditional_t<std::is_const_v<Owner>, const field&, field&>;
+};
@@ -0,0 +1,28 @@
+// ---------------------------------------------
+// SHARED – THREAD PINNING
+// ---------------------------------------------
+
+/*
+   Multi-threaded benchmarks pin each worker to its own CPU so the
+   scheduler can't migrate it mid-run (which would drag its cache and
+   TLB state along and add noise). Worker i goes to CPU i % cpuCount().
+*/
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+
+inline unsigned cpuCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Pins the calling thread; returns false if the kernel refused (e.g. restricted cpuset).
+inline bool pinCurrentThread(unsigned cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % cpuCount(), &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,96 @@
+// ---------------------------------------------
+// SHARED – STATIC THREAD POOL
+// ---------------------------------------------
+
+/*
+   A fork/join pool for bandwidth benchmarks:
+   - N workers created once, worker i pinned to CPU i (thread_affinity.hpp)
+   - run(task) calls task(i) on every worker and returns when all are done
+   - work is split with staticPartition(): worker i always gets the same
+     contiguous slice, so the pages it first-touched are the pages it reads
+
+   Thread start-up cost stays out of the timed region because the workers
+   already exist when run() is called.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "thread_affinity.hpp"
+
+// [begin, end) of part `index` when `count` items are split into `parts` slices.
+inline std::pair<size_t, size_t> staticPartition(size_t count, size_t index, size_t parts) {
+    return {count * index / parts, count * (index + 1) / parts};
+}
+
+class StaticThreadPool {
+public:
+    explicit StaticThreadPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~StaticThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    StaticThreadPool(const StaticThreadPool&) = delete;
+    StaticThreadPool& operator=(const StaticThreadPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    // Runs task(workerIndex) once on every worker and waits for all of them.
+    void run(const std::function<void(size_t)>& task) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_ = &task;
+        pending_ = workers_.size();
+        ++generation_;
+        wake_.notify_all();
+        done_.wait(lock, [this] { return pending_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void workerLoop(size_t index) {
+        pinCurrentThread(static_cast<unsigned>(index));
+        size_t seen = 0;
+
+        for (;;) {
+            const std::function<void(size_t)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+                task = task_;
+            }
+
+            (*task)(index);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t generation_ = 0;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+};
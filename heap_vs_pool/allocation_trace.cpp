@@ -0,0 +1,227 @@
+#include "allocation_trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+constexpr size_t CHURN_LIVE_OBJECTS = 10'000;
+constexpr size_t PC_MAX_DEPTH = 64;
+constexpr size_t TRANSIENT_MAX_LIFETIME = 16;
+constexpr unsigned LONG_LIVED_PERCENT = 5;
+
+// Builds a trace event by event; frees can be scheduled a number of events ahead.
+class TraceBuilder {
+public:
+    explicit TraceBuilder(size_t threads) { trace_.threads = threads; }
+
+    uint64_t alloc(uint32_t size, uint32_t thread) {
+        uint64_t object = trace_.objects++;
+        owner_.push_back(thread);
+        freed_.push_back(0);
+        trace_.events.push_back({TraceEvent::Alloc, thread, size, object});
+        releaseDue();
+        return object;
+    }
+
+    void free(uint64_t object, uint32_t thread) {
+        freed_[object] = 1;
+        trace_.events.push_back({TraceEvent::Free, thread, 0, object});
+    }
+
+    void freeLater(uint64_t object, uint32_t thread, size_t lifetime) {
+        due_.push({trace_.events.size() + lifetime, object, thread});
+    }
+
+    // Pending frees in due order, then everything still live on its own thread.
+    AllocationTrace finish() {
+        while (!due_.empty()) popDue();
+        for (uint64_t object = 0; object < trace_.objects; ++object) {
+            if (!freed_[object]) free(object, owner_[object]);
+        }
+        return std::move(trace_);
+    }
+
+private:
+    struct Due {
+        size_t at;
+        uint64_t object;
+        uint32_t thread;
+        bool operator>(const Due& other) const { return at > other.at; }
+    };
+
+    void releaseDue() {
+        while (!due_.empty() && due_.top().at <= trace_.events.size()) popDue();
+    }
+
+    void popDue() {
+        Due d = due_.top();
+        due_.pop();
+        free(d.object, d.thread);
+    }
+
+    AllocationTrace trace_;
+    std::vector<uint32_t> owner_;
+    std::vector<uint8_t> freed_;
+    std::priority_queue<Due, std::vector<Due>, std::greater<Due>> due_;
+};
+
+// Typical order/message sizes.
+uint32_t orderSize(std::mt19937_64& rng) {
+    static constexpr uint32_t SIZES[] = {48, 64, 96, 128, 160, 256};
+    return SIZES[rng() % std::size(SIZES)];
+}
+
+AllocationTrace churnTrace(size_t allocations, size_t threads, std::mt19937_64& rng) {
+    TraceBuilder builder(threads);
+    std::vector<std::vector<uint64_t>> live(threads);
+    size_t perThread = std::max<size_t>(1, CHURN_LIVE_OBJECTS / threads);
+
+    size_t made = 0;
+    for (uint32_t t = 0; t < threads; ++t) {
+        for (size_t i = 0; i < perThread && made < allocations; ++i, ++made) {
+            live[t].push_back(builder.alloc(orderSize(rng), t));
+        }
+    }
+    for (uint32_t t = 0; made < allocations; t = (t + 1) % threads, ++made) {
+        if (live[t].empty()) {
+            live[t].push_back(builder.alloc(orderSize(rng), t));
+            continue;
+        }
+        uint64_t& victim = live[t][rng() % live[t].size()];
+        builder.free(victim, t);
+        victim = builder.alloc(orderSize(rng), t);
+    }
+    return builder.finish();
+}
+
+AllocationTrace producerConsumerTrace(size_t allocations, size_t threads, std::mt19937_64& rng) {
+    TraceBuilder builder(threads);
+    size_t pairs = std::max<size_t>(1, threads / 2);
+
+    for (size_t made = 0; made < allocations; ++made) {
+        size_t pair = made % pairs;
+        uint32_t producer = static_cast<uint32_t>(2 * pair);
+        uint32_t consumer = threads == 1 ? 0 : producer + 1;
+        uint64_t object = builder.alloc(orderSize(rng), producer);
+        builder.freeLater(object, consumer, 1 + rng() % PC_MAX_DEPTH);
+    }
+    return builder.finish();
+}
+
+AllocationTrace mixedTrace(size_t allocations, size_t threads, std::mt19937_64& rng) {
+    TraceBuilder builder(threads);
+
+    for (size_t made = 0; made < allocations; ++made) {
+        uint32_t t = static_cast<uint32_t>(made % threads);
+        if (rng() % 100 < LONG_LIVED_PERCENT) {
+            builder.alloc(static_cast<uint32_t>(256 + rng() % 3841), t); // freed by finish()
+        } else {
+            uint64_t object = builder.alloc(static_cast<uint32_t>(16 + rng() % 113), t);
+            builder.freeLater(object, t, 1 + rng() % TRANSIENT_MAX_LIFETIME);
+        }
+    }
+    return builder.finish();
+}
+
+AllocationTrace generateTrace(const std::string& kind, size_t allocations, size_t threads, uint64_t seed) {
+    threads = std::max<size_t>(1, threads);
+    std::mt19937_64 rng(seed);
+    if (kind == "churn") return churnTrace(allocations, threads, rng);
+    if (kind == "pc") return producerConsumerTrace(allocations, threads, rng);
+    if (kind == "mixed") return mixedTrace(allocations, threads, rng);
+    throw std::invalid_argument("unknown trace generator '" + kind + "' (expected churn, pc or mixed)");
+}
+
+AllocationTrace loadTrace(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open trace '" + path + "'");
+
+    AllocationTrace trace;
+    std::unordered_map<uint64_t, uint64_t> active; // file id → dense object
+    std::unordered_map<uint32_t, uint32_t> threadIndex; // file thread id → dense thread
+    std::vector<uint32_t> owner;
+    std::string line;
+    for (size_t lineNo = 1; std::getline(in, line); ++lineNo) {
+        auto fail = [&](const std::string& why) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNo) + ": " + why);
+        };
+        std::istringstream fields(line);
+        std::string kind;
+        if (!(fields >> kind) || kind[0] == '#') continue;
+
+        // Renumbers a file thread id; a sparse id must not spawn thousands of workers.
+        auto denseThread = [&](uint32_t fileThread) {
+            auto [it, added] = threadIndex.emplace(fileThread, static_cast<uint32_t>(threadIndex.size()));
+            if (added && threadIndex.size() > MAX_TRACE_THREADS) {
+                fail("more than " + std::to_string(MAX_TRACE_THREADS) + " distinct thread ids");
+            }
+            return it->second;
+        };
+
+        uint64_t id;
+        uint32_t size = 0, thread;
+        if (kind == "a") {
+            if (!(fields >> id >> size >> thread)) fail("expected 'a <id> <size> <thread>'");
+            thread = denseThread(thread);
+            if (!active.emplace(id, trace.objects).second) fail("id allocated twice without a free");
+            owner.push_back(thread);
+            trace.events.push_back({TraceEvent::Alloc, thread, size, trace.objects++});
+        } else if (kind == "f") {
+            if (!(fields >> id >> thread)) fail("expected 'f <id> <thread>'");
+            thread = denseThread(thread);
+            auto it = active.find(id);
+            if (it == active.end()) fail("free of an id that is not allocated");
+            trace.events.push_back({TraceEvent::Free, thread, 0, it->second});
+            active.erase(it);
+        } else {
+            fail("unknown event '" + kind + "'");
+        }
+    }
+    trace.threads = threadIndex.size();
+
+    std::vector<uint64_t> leaked;
+    for (const auto& [id, object] : active) leaked.push_back(object);
+    std::sort(leaked.begin(), leaked.end());
+    for (uint64_t object : leaked) trace.events.push_back({TraceEvent::Free, owner[object], 0, object});
+    return trace;
+}
+
+void saveTrace(const AllocationTrace& trace, const std::string& path) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("cannot write trace '" + path + "'");
+
+    out << "# heap_vs_pool allocation trace: " << trace.events.size() << " events, " << trace.threads
+        << " threads\n";
+    for (const TraceEvent& e : trace.events) {
+        if (e.kind == TraceEvent::Alloc) out << "a " << e.object << ' ' << e.size << ' ' << e.thread << '\n';
+        else out << "f " << e.object << ' ' << e.thread << '\n';
+    }
+}
+
+TraceStats traceStats(const AllocationTrace& trace) {
+    TraceStats stats;
+    std::vector<uint32_t> size(trace.objects), owner(trace.objects);
+    size_t liveObjects = 0, liveBytes = 0;
+
+    for (const TraceEvent& e : trace.events) {
+        if (e.kind == TraceEvent::Alloc) {
+            size[e.object] = e.size;
+            owner[e.object] = e.thread;
+            ++stats.allocations;
+            stats.totalBytes += e.size;
+            ++liveObjects;
+            liveBytes += e.size;
+            stats.peakLiveObjects = std::max(stats.peakLiveObjects, liveObjects);
+            stats.peakLiveBytes = std::max(stats.peakLiveBytes, liveBytes);
+        } else {
+            if (owner[e.object] != e.thread) ++stats.crossThreadFrees;
+            --liveObjects;
+            liveBytes -= size[e.object];
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,69 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – ALLOCATION TRACES
+// ---------------------------------------------------------
+
+/*
+   A trace is the allocation history of a program: which thread allocated
+   how many bytes, and which thread freed it when. Replaying one against
+   different allocators compares them on the same workload.
+
+   File format – plain text, one event per line, '#' starts a comment:
+
+       a <id> <size> <thread>      allocate `size` bytes on `thread`
+       f <id> <thread>             free the allocation `id` on `thread`
+
+   An object's lifetime is the distance between its 'a' and 'f' lines, and
+   'f' may name a different thread than 'a' (cross-thread free). Ids can be
+   any unsigned 64-bit numbers and may be reused after their free; they are
+   renumbered densely on load. Thread ids are any unsigned 32-bit numbers
+   and are renumbered 0..n-1 in order of first appearance; a trace may use
+   at most MAX_TRACE_THREADS of them, since each becomes a pinned replay
+   thread. Objects never freed are freed at the end.
+
+   Synthetic generators:
+   - churn    : every thread keeps ~10k live objects and replaces a random one
+   - pc       : producer/consumer pairs; the consumer frees 1-64 events later
+   - mixed    : 5% long-lived (256 B-4 KB, live to the end) + 95% transient
+                (16-128 B, freed within 16 events)
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr size_t MAX_TRACE_THREADS = 1024;
+
+struct TraceEvent {
+    enum Kind : uint8_t { Alloc, Free };
+
+    Kind kind;
+    uint32_t thread;
+    uint32_t size;   // Alloc only
+    uint64_t object; // dense index 0..objects-1
+};
+
+struct AllocationTrace {
+    std::vector<TraceEvent> events;
+    size_t threads = 0;
+    size_t objects = 0;
+};
+
+struct TraceStats {
+    size_t allocations = 0;
+    size_t crossThreadFrees = 0;
+    size_t peakLiveObjects = 0;
+    size_t peakLiveBytes = 0;
+    size_t totalBytes = 0;
+};
+
+// Throws std::runtime_error on unreadable files and malformed lines.
+AllocationTrace loadTrace(const std::string& path);
+void saveTrace(const AllocationTrace& trace, const std::string& path);
+
+// kind: "churn", "pc" or "mixed"; throws std::invalid_argument otherwise.
+AllocationTrace generateTrace(const std::string& kind, size_t allocations, size_t threads, uint64_t seed = 42);
+
+TraceStats traceStats(const AllocationTrace& trace);
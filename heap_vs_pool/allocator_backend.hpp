@@ -0,0 +1,78 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – PLUGGABLE ALLOCATOR BACKENDS
+// ---------------------------------------------------------
+
+/*
+   The trace replayer talks to allocators only through this interface, so
+   every backend runs exactly the same events.
+
+   - `thread` is the trace's thread index; a thread only ever passes its own
+     index, so backends can keep per-thread state in a vector without locks.
+   - deallocate() gets the size back (as sized delete does), and may be
+     called on another thread than allocate() was.
+   - prepare() runs before a replay with the thread count and an upper bound
+     on live objects, for backends that size themselves up front. Replay
+     threads drift apart, so that bound is the trace's allocation count,
+     not its peak: only touched pages cost memory.
+
+   Backends:
+   - malloc    : glibc malloc/free (or whatever LD_PRELOAD put in its place)
+   - arena     : jemalloc-style; one mutex-protected arena per thread with a
+                 bin per size class. A 16-byte header records the owning
+                 arena, so a cross-thread free goes back where it came from.
+   - sizeclass : tcmalloc-style; unlocked per-thread free lists per size
+                 class, refilled from / spilled to a locked central list in
+                 batches. Frees use the size, so there is no header.
+   - pool      : ConcurrentObjectPool of 256-byte blocks with per-thread caches;
+                 larger requests fall through to malloc
+   - lib:PATH  : malloc/free of a shared library loaded with dlopen
+   arena and sizeclass share one size-class table (16-byte steps to 128,
+   then four classes per doubling up to 4 KB) and carve 1 MB page-backed
+   chunks; larger requests fall through to malloc. Neither returns memory
+   to the OS before the backend is destroyed.
+
+   usage() reports what the allocator holds versus what it has handed
+   out, for fragmentation tracking; call it only while no thread is inside
+   the backend. malloc answers from mallinfo2() (the whole process heap),
+   the others from their own per-thread counters plus the pages they have
+   carved. Requests they pass on to malloc are not in held/handedOut: they
+   are reported apart as fallThroughBytes, at their requested size, so the
+   backend's own overhead is never diluted by malloc's. lib:PATH cannot
+   tell and reports nothing.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+struct BackendUsage {
+    bool known = false;
+    size_t heldBytes = 0;      // obtained from the OS and not given back, live or cached
+    size_t handedOutBytes = 0; // in live blocks, including size-class rounding
+    size_t fallThroughBytes = 0; // live requests passed on to malloc, as requested
+};
+
+class AllocatorBackend {
+public:
+    virtual ~AllocatorBackend() = default;
+
+    virtual const char* name() const = 0;
+    virtual void prepare(size_t /*threads*/, size_t /*maxLiveObjects*/) {}
+    virtual void* allocate(size_t size, size_t thread) = 0;
+    virtual void deallocate(void* p, size_t size, size_t thread) = 0;
+    // Called by each replay thread once it has run all of its events.
+    virtual void threadDone(size_t /*thread*/) {}
+    virtual BackendUsage usage() const { return {}; }
+};
+
+// Throws std::invalid_argument for unknown names.
+std::unique_ptr<AllocatorBackend> makeBackend(const std::string& name, PagePolicy policy);
+std::vector<std::string> backendNames();
+
+// Resident set size of this process from /proc/self/statm, or 0 if unavailable.
+long long residentBytes();
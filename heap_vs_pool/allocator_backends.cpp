@@ -0,0 +1,440 @@
+#include "allocator_backend.hpp"
+
+#include <dlfcn.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "concurrent_pool.hpp"
+
+constexpr size_t POOL_BLOCK_SIZE = 256;
+constexpr size_t CHUNK_BYTES = 1 << 20;    // slab refill unit for arena / sizeclass
+constexpr size_t TRANSFER_BATCH = 32;      // objects moved between thread cache and central list
+constexpr size_t ARENA_HEADER = 16;        // keeps user pointers 16-byte aligned
+
+// ---- shared size classes (16 B granularity up to 128, then 4 classes per doubling) ----
+
+class SizeClasses {
+public:
+    static constexpr size_t MAX_SIZE = 4096;
+
+    SizeClasses() {
+        for (size_t size = 16; size <= 128; size += 16) sizes_[count_++] = size;
+        for (size_t base = 128; base < MAX_SIZE; base *= 2) {
+            for (size_t step = 1; step <= 4; ++step) sizes_[count_++] = base + base / 4 * step;
+        }
+        for (size_t granule = 0, cls = 0; granule < lookup_.size(); ++granule) {
+            while (sizes_[cls] < granule * 16) ++cls;
+            lookup_[granule] = static_cast<uint8_t>(cls);
+        }
+    }
+
+    size_t count() const { return count_; }
+    size_t classOf(size_t size) const { return lookup_[(size + 15) / 16]; }
+    size_t sizeOf(size_t cls) const { return sizes_[cls]; }
+
+private:
+    std::array<size_t, 64> sizes_{};
+    std::array<uint8_t, MAX_SIZE / 16 + 1> lookup_{};
+    size_t count_ = 0;
+};
+
+const SizeClasses& sizeClasses() {
+    static const SizeClasses classes;
+    return classes;
+}
+
+// Intrusive LIFO of free objects of one size class.
+struct FreeList {
+    struct Node {
+        Node* next;
+    };
+
+    Node* head = nullptr;
+    size_t count = 0;
+
+    void push(void* p) {
+        Node* n = static_cast<Node*>(p);
+        n->next = head;
+        head = n;
+        ++count;
+    }
+
+    void* pop() {
+        Node* n = head;
+        head = n->next;
+        --count;
+        return n;
+    }
+};
+
+// Hands out memory carved from page-backed chunks; chunks are released on destruction.
+class ChunkSource {
+public:
+    explicit ChunkSource(PagePolicy policy) : policy_(policy) {}
+
+    ~ChunkSource() {
+        for (void* chunk : chunks_) freePages(chunk, CHUNK_BYTES, policy_);
+    }
+
+    ChunkSource(const ChunkSource&) = delete;
+    ChunkSource& operator=(const ChunkSource&) = delete;
+
+    // Fills `list` with objects of `size` bytes; caller holds whatever lock guards `list`.
+    void carve(FreeList& list, size_t size, size_t objects) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < objects; ++i) {
+            if (bump_ + size > end_) refill();
+            list.push(bump_);
+            bump_ += size;
+        }
+    }
+
+    size_t bytesMapped() const { return chunks_.size() * CHUNK_BYTES; }
+
+private:
+    void refill() {
+        void* chunk = allocatePages(CHUNK_BYTES, policy_);
+        if (chunk == nullptr) throw std::bad_alloc();
+        chunks_.push_back(chunk);
+        bump_ = static_cast<unsigned char*>(chunk);
+        end_ = bump_ + CHUNK_BYTES;
+    }
+
+    PagePolicy policy_;
+    std::mutex mutex_;
+    std::vector<void*> chunks_;
+    unsigned char* bump_ = nullptr;
+    unsigned char* end_ = nullptr;
+};
+
+void* largeAllocate(size_t size) {
+    void* p = std::malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+// A byte count owned by one thread; goes negative on the thread that frees
+// what another allocated, only the sum over threads is meaningful.
+struct alignas(64) ThreadBytes {
+    long long bytes = 0;
+};
+
+long long sumBytes(const std::vector<ThreadBytes>& counters) {
+    long long sum = 0;
+    for (const ThreadBytes& c : counters) sum += c.bytes;
+    return sum;
+}
+
+BackendUsage usageOf(size_t held, long long handedOut, long long large) {
+    return {true, held, static_cast<size_t>(handedOut), static_cast<size_t>(large)};
+}
+
+// ---- glibc ----
+
+class MallocBackend : public AllocatorBackend {
+public:
+    const char* name() const override { return "malloc"; }
+    void* allocate(size_t size, size_t) override { return largeAllocate(size); }
+    void deallocate(void* p, size_t, size_t) override { std::free(p); }
+
+    BackendUsage usage() const override {
+        struct mallinfo2 info = mallinfo2();
+        return {true, info.arena + info.hblkhd, info.uordblks + info.hblkhd};
+    }
+};
+
+// ---- fixed-size pool ----
+
+class PoolBackend : public AllocatorBackend {
+    struct alignas(16) Block {
+        unsigned char bytes[POOL_BLOCK_SIZE];
+    };
+    using Pool = ConcurrentObjectPool<Block>;
+
+public:
+    explicit PoolBackend(PagePolicy policy) : policy_(policy) {}
+
+    const char* name() const override { return "pool"; }
+
+    void prepare(size_t threads, size_t maxLiveObjects) override {
+        caches_.clear();
+        // Every thread may additionally park up to two magazines in its cache.
+        pool_.emplace(maxLiveObjects + threads * 2 * Pool::MAGAZINE_SIZE + Pool::MAGAZINE_SIZE, policy_);
+        caches_.resize(threads);
+        for (auto& cache : caches_) cache.emplace(*pool_);
+        blocks_.assign(threads, {});
+        large_.assign(threads, {});
+    }
+
+    void* allocate(size_t size, size_t thread) override {
+        if (size > POOL_BLOCK_SIZE) {
+            large_[thread].bytes += size;
+            return largeAllocate(size);
+        }
+        ++blocks_[thread].bytes;
+        return caches_[thread]->allocate();
+    }
+
+    void deallocate(void* p, size_t size, size_t thread) override {
+        if (size > POOL_BLOCK_SIZE) {
+            large_[thread].bytes -= size;
+            std::free(p);
+        } else {
+            --blocks_[thread].bytes;
+            caches_[thread]->deallocate(p);
+        }
+    }
+
+    void threadDone(size_t thread) override { caches_[thread]->flush(); }
+
+    BackendUsage usage() const override {
+        size_t carved = pool_ ? pool_->carved() : 0;
+        return usageOf(carved * sizeof(Block), sumBytes(blocks_) * sizeof(Block), sumBytes(large_));
+    }
+
+private:
+    PagePolicy policy_;
+    std::optional<Pool> pool_;
+    std::vector<std::optional<Pool::ThreadCache>> caches_;
+    std::vector<ThreadBytes> blocks_; // live blocks, not bytes
+    std::vector<ThreadBytes> large_;
+};
+
+// ---- jemalloc-style: one locked arena per thread, frees return to the owning arena ----
+
+class ArenaBackend : public AllocatorBackend {
+    struct alignas(64) Arena {
+        std::mutex mutex;
+        std::vector<FreeList> bins;
+        std::optional<ChunkSource> chunks;
+        long long handedOut = 0;
+    };
+
+    struct Header {
+        uint32_t arena;
+        uint32_t sizeClass;
+    };
+    static_assert(sizeof(Header) <= ARENA_HEADER);
+
+public:
+    explicit ArenaBackend(PagePolicy policy) : policy_(policy) {}
+
+    const char* name() const override { return "arena"; }
+
+    void prepare(size_t threads, size_t) override {
+        arenas_ = std::vector<Arena>(threads);
+        for (Arena& arena : arenas_) {
+            arena.bins.resize(sizeClasses().count());
+            arena.chunks.emplace(policy_);
+        }
+        large_.assign(threads, {});
+    }
+
+    void* allocate(size_t size, size_t thread) override {
+        if (size + ARENA_HEADER > SizeClasses::MAX_SIZE) {
+            large_[thread].bytes += size;
+            return largeAllocate(size);
+        }
+
+        size_t cls = sizeClasses().classOf(size + ARENA_HEADER);
+        Arena& arena = arenas_[thread];
+        unsigned char* block;
+        {
+            std::lock_guard<std::mutex> lock(arena.mutex);
+            FreeList& bin = arena.bins[cls];
+            if (bin.count == 0) arena.chunks->carve(bin, sizeClasses().sizeOf(cls), TRANSFER_BATCH);
+            block = static_cast<unsigned char*>(bin.pop());
+            arena.handedOut += sizeClasses().sizeOf(cls);
+        }
+        new (block) Header{static_cast<uint32_t>(thread), static_cast<uint32_t>(cls)};
+        return block + ARENA_HEADER;
+    }
+
+    void deallocate(void* p, size_t size, size_t thread) override {
+        if (size + ARENA_HEADER > SizeClasses::MAX_SIZE) {
+            large_[thread].bytes -= size;
+            return std::free(p);
+        }
+
+        unsigned char* block = static_cast<unsigned char*>(p) - ARENA_HEADER;
+        Header header = *reinterpret_cast<Header*>(block);
+        Arena& arena = arenas_[header.arena];
+        std::lock_guard<std::mutex> lock(arena.mutex);
+        arena.bins[header.sizeClass].push(block);
+        arena.handedOut -= sizeClasses().sizeOf(header.sizeClass);
+    }
+
+    BackendUsage usage() const override {
+        size_t held = 0;
+        long long handedOut = 0;
+        for (const Arena& arena : arenas_) {
+            held += arena.chunks->bytesMapped();
+            handedOut += arena.handedOut;
+        }
+        return usageOf(held, handedOut, sumBytes(large_));
+    }
+
+private:
+    PagePolicy policy_;
+    std::vector<Arena> arenas_;
+    std::vector<ThreadBytes> large_;
+};
+
+// ---- tcmalloc-style: lock-free thread caches over locked central lists ----
+
+class SizeClassBackend : public AllocatorBackend {
+    struct alignas(64) Central {
+        std::mutex mutex;
+        FreeList list;
+    };
+
+    struct alignas(64) ThreadCache {
+        std::vector<FreeList> lists;
+        long long handedOut = 0;
+        long long large = 0;
+    };
+
+public:
+    explicit SizeClassBackend(PagePolicy policy) : chunks_(policy), central_(sizeClasses().count()) {}
+
+    const char* name() const override { return "sizeclass"; }
+
+    void prepare(size_t threads, size_t) override {
+        caches_ = std::vector<ThreadCache>(threads);
+        for (ThreadCache& cache : caches_) cache.lists.resize(sizeClasses().count());
+    }
+
+    void* allocate(size_t size, size_t thread) override {
+        ThreadCache& cache = caches_[thread];
+        if (size > SizeClasses::MAX_SIZE) {
+            cache.large += size;
+            return largeAllocate(size);
+        }
+
+        size_t cls = sizeClasses().classOf(size);
+        FreeList& list = cache.lists[cls];
+        if (list.count == 0) fetch(cls, list);
+        cache.handedOut += sizeClasses().sizeOf(cls);
+        return list.pop();
+    }
+
+    // The object joins the *freeing* thread's cache, whoever allocated it.
+    void deallocate(void* p, size_t size, size_t thread) override {
+        ThreadCache& cache = caches_[thread];
+        if (size > SizeClasses::MAX_SIZE) {
+            cache.large -= size;
+            return std::free(p);
+        }
+
+        size_t cls = sizeClasses().classOf(size);
+        FreeList& list = cache.lists[cls];
+        cache.handedOut -= sizeClasses().sizeOf(cls);
+        list.push(p);
+        if (list.count >= 2 * TRANSFER_BATCH) release(cls, list, TRANSFER_BATCH);
+    }
+
+    void threadDone(size_t thread) override {
+        for (size_t cls = 0; cls < sizeClasses().count(); ++cls) {
+            FreeList& list = caches_[thread].lists[cls];
+            release(cls, list, list.count);
+        }
+    }
+
+    BackendUsage usage() const override {
+        long long handedOut = 0, large = 0;
+        for (const ThreadCache& cache : caches_) {
+            handedOut += cache.handedOut;
+            large += cache.large;
+        }
+        return usageOf(chunks_.bytesMapped(), handedOut, large);
+    }
+
+private:
+    void fetch(size_t cls, FreeList& into) {
+        Central& central = central_[cls];
+        std::lock_guard<std::mutex> lock(central.mutex);
+        if (central.list.count < TRANSFER_BATCH) {
+            chunks_.carve(central.list, sizeClasses().sizeOf(cls), TRANSFER_BATCH);
+        }
+        for (size_t i = 0; i < TRANSFER_BATCH; ++i) into.push(central.list.pop());
+    }
+
+    void release(size_t cls, FreeList& from, size_t n) {
+        if (n == 0) return;
+        Central& central = central_[cls];
+        std::lock_guard<std::mutex> lock(central.mutex);
+        for (size_t i = 0; i < n; ++i) central.list.push(from.pop());
+    }
+
+    ChunkSource chunks_;
+    std::vector<Central> central_;
+    std::vector<ThreadCache> caches_;
+};
+
+// ---- an external allocator's malloc/free, loaded with dlopen ----
+
+class LibraryBackend : public AllocatorBackend {
+    using MallocFn = void* (*)(size_t);
+    using FreeFn = void (*)(void*);
+
+public:
+    explicit LibraryBackend(const std::string& path) : name_("lib:" + path) {
+        handle_ = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle_ == nullptr) throw std::invalid_argument("cannot load allocator: " + std::string(dlerror()));
+        malloc_ = reinterpret_cast<MallocFn>(dlsym(handle_, "malloc"));
+        free_ = reinterpret_cast<FreeFn>(dlsym(handle_, "free"));
+        if (malloc_ == nullptr || free_ == nullptr) {
+            dlclose(handle_);
+            throw std::invalid_argument(path + " does not export malloc/free");
+        }
+    }
+
+    ~LibraryBackend() override { dlclose(handle_); }
+
+    const char* name() const override { return name_.c_str(); }
+
+    void* allocate(size_t size, size_t) override {
+        void* p = malloc_(size);
+        if (p == nullptr) throw std::bad_alloc();
+        return p;
+    }
+
+    void deallocate(void* p, size_t, size_t) override { free_(p); }
+
+private:
+    std::string name_;
+    void* handle_;
+    MallocFn malloc_;
+    FreeFn free_;
+};
+
+long long residentBytes() {
+    std::FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr) return 0;
+    long long sizePages = 0, residentPages = 0;
+    int fields = std::fscanf(statm, "%lld %lld", &sizePages, &residentPages);
+    std::fclose(statm);
+    return fields == 2 ? residentPages * sysconf(_SC_PAGESIZE) : 0;
+}
+
+std::vector<std::string> backendNames() {
+    return {"malloc", "arena", "sizeclass", "pool"};
+}
+
+std::unique_ptr<AllocatorBackend> makeBackend(const std::string& name, PagePolicy policy) {
+    if (name == "malloc") return std::make_unique<MallocBackend>();
+    if (name == "arena") return std::make_unique<ArenaBackend>(policy);
+    if (name == "sizeclass") return std::make_unique<SizeClassBackend>(policy);
+    if (name == "pool") return std::make_unique<PoolBackend>(policy);
+    if (name.rfind("lib:", 0) == 0) return std::make_unique<LibraryBackend>(name.substr(4));
+    throw std::invalid_argument("unknown allocator '" + name + "' (expected malloc, arena, sizeclass, pool or lib:PATH)");
+}
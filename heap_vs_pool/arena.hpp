@@ -0,0 +1,168 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – Arena (bump allocator with rewind)
+// ---------------------------------------------------------
+
+/*
+   For allocations that all die together – everything built while
+   handling one market-data message – freeing them one by one is wasted
+   work. An Arena bump-allocates from big chunks and frees by moving the
+   bump pointer back:
+
+       Arena arena;
+       for (const Message& m : feed) {
+           Arena::Scope scope(arena);                 // rewinds on exit
+           auto* legs = arena.allocateArray<Leg>(m.legCount);
+           Arena::Marker beforeScratch = arena.mark();
+           void* scratch = arena.allocate(256, 64);   // cache-line aligned
+           ...
+           arena.rewind(beforeScratch);               // scratch gone, legs kept
+       }
+
+   - allocate(bytes, alignment) rounds the bump pointer up to any
+     power-of-two alignment; the chunk start is page aligned.
+   - Chunk chaining: when a chunk is full the next one in the chain is
+     reused, or a new one (at least `bytes + alignment` big) is mapped and
+     linked in. Rewinding keeps every chunk, so after warm-up a message
+     never maps memory.
+   - mark() / rewind() nest like a stack; rewinding to a marker taken
+     after the current position is a bug and is not checked.
+   - No destructors run on rewind: only put trivially destructible
+     objects in an arena (create() enforces it).
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+class Arena {
+    struct Chunk {
+        unsigned char* begin;
+        size_t size;
+    };
+
+public:
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+
+    struct Marker {
+        size_t chunk;
+        unsigned char* top;
+    };
+
+    // Rewinds the arena to where it was when the scope began.
+    class Scope {
+    public:
+        explicit Scope(Arena& arena) : arena_(arena), marker_(arena.mark()) {}
+        ~Scope() { arena_.rewind(marker_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Arena& arena_;
+        Marker marker_;
+    };
+
+    explicit Arena(size_t chunkBytes = DEFAULT_CHUNK_BYTES, PagePolicy policy = PagePolicy::Small4K)
+        : chunkBytes_(roundUpToPage(chunkBytes == 0 ? 1 : chunkBytes, policy)), policy_(policy) {
+        link(0, chunkBytes_);
+        enter(0);
+    }
+
+    ~Arena() {
+        for (Chunk& chunk : chunks_) freePages(chunk.begin, chunk.size, policy_);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // `alignment` must be a power of two.
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        unsigned char* p = alignUp(top_, alignment);
+        if (bytes > static_cast<size_t>(end_ - p)) {
+            nextChunk(bytes, alignment);
+            p = alignUp(top_, alignment);
+        }
+        top_ = p + bytes;
+        return p;
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+    }
+
+    // Uninitialised storage for `n` objects of T.
+    template<typename T>
+    T* allocateArray(size_t n) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        return static_cast<T*>(allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    Marker mark() const { return {current_, top_}; }
+
+    void rewind(Marker marker) {
+        current_ = marker.chunk;
+        top_ = marker.top;
+        end_ = chunks_[current_].begin + chunks_[current_].size;
+    }
+
+    void reset() { enter(0); }
+
+    // Bytes between the start of the chain and the bump pointer, alignment
+    // padding and the unused tails of earlier chunks included.
+    size_t bytesUsed() const {
+        size_t used = 0;
+        for (size_t i = 0; i < current_; ++i) used += chunks_[i].size;
+        return used + (top_ - chunks_[current_].begin);
+    }
+
+    size_t bytesReserved() const {
+        size_t reserved = 0;
+        for (const Chunk& chunk : chunks_) reserved += chunk.size;
+        return reserved;
+    }
+
+    size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    static unsigned char* alignUp(unsigned char* p, size_t alignment) {
+        auto address = reinterpret_cast<uintptr_t>(p);
+        return p + ((alignment - address % alignment) % alignment);
+    }
+
+    void nextChunk(size_t bytes, size_t alignment) {
+        size_t next = current_ + 1;
+        if (next == chunks_.size() || chunks_[next].size < bytes + alignment) {
+            link(next, std::max(chunkBytes_, roundUpToPage(bytes + alignment, policy_)));
+        }
+        enter(next);
+    }
+
+    void link(size_t at, size_t bytes) {
+        void* memory = allocatePages(bytes, policy_);
+        if (memory == nullptr) throw std::bad_alloc();
+        chunks_.insert(chunks_.begin() + at, {static_cast<unsigned char*>(memory), bytes});
+    }
+
+    void enter(size_t chunk) {
+        current_ = chunk;
+        top_ = chunks_[chunk].begin;
+        end_ = top_ + chunks_[chunk].size;
+    }
+
+    size_t chunkBytes_;
+    PagePolicy policy_;
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;
+    unsigned char* top_ = nullptr;
+    unsigned char* end_ = nullptr;
+};
@@ -0,0 +1,171 @@
+#include "concurrent_benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_pool.hpp"
+#include "fast_random.hpp"
+#include "thread_pool.hpp"
+#include "trade.hpp"
+
+constexpr size_t LIVE_PER_THREAD = 10'000;
+constexpr size_t RING_CAPACITY = 1024;
+
+// Single-producer / single-consumer ring of trade pointers.
+class TradeRing {
+public:
+    void push(Trade* t) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        while (head - tail_.load(std::memory_order_acquire) == RING_CAPACITY) std::this_thread::yield();
+        items_[head % RING_CAPACITY] = t;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    Trade* pop() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        while (head_.load(std::memory_order_acquire) == tail) std::this_thread::yield();
+        Trade* t = items_[tail % RING_CAPACITY];
+        tail_.store(tail + 1, std::memory_order_release);
+        return t;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) Trade* items_[RING_CAPACITY];
+};
+
+struct alignas(64) PaddedChecksum {
+    long long value = 0;
+};
+
+// Both allocators behind the same per-thread interface.
+struct HeapHandle {
+    Trade* make(int id) { return new Trade{id, 100.5 + id, 10}; }
+    void drop(Trade* t) { delete t; }
+};
+
+struct PoolHandle {
+    ConcurrentObjectPool<Trade>::ThreadCache cache;
+
+    explicit PoolHandle(ConcurrentObjectPool<Trade>& pool) : cache(pool.threadCache()) {}
+    Trade* make(int id) { return cache.create(id, 100.5 + id, 10); }
+    void drop(Trade* t) { cache.destroy(t); }
+};
+
+template<typename Handle>
+long long symmetricWorker(Handle& handle, size_t ops, uint64_t seed) {
+    std::vector<Trade*> live(LIVE_PER_THREAD);
+    for (size_t i = 0; i < LIVE_PER_THREAD; ++i) live[i] = handle.make(static_cast<int>(i));
+
+    FastRandom rng(seed);
+    long long checksum = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        Trade*& victim = live[rng.below(LIVE_PER_THREAD)];
+        checksum += victim->id;
+        handle.drop(victim);
+        victim = handle.make(static_cast<int>(i));
+    }
+    for (Trade* t : live) handle.drop(t);
+    return checksum;
+}
+
+template<typename Handle>
+long long producerWorker(Handle& handle, TradeRing& ring, size_t ops) {
+    for (size_t i = 0; i < ops; ++i) ring.push(handle.make(static_cast<int>(i)));
+    return 0;
+}
+
+template<typename Handle>
+long long consumerWorker(Handle& handle, TradeRing& ring, size_t ops) {
+    long long checksum = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        Trade* t = ring.pop();
+        checksum += t->id;
+        handle.drop(t);
+    }
+    return checksum;
+}
+
+double timeThreads(StaticThreadPool& threads, const std::string& label, size_t ops,
+                   std::vector<PaddedChecksum>& checksums, const std::function<void(size_t)>& task) {
+    for (auto& c : checksums) c.value = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    threads.run(task);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    long long checksum = 0;
+    for (const auto& c : checksums) checksum += c.value;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double mops = ops / seconds / 1e6;
+    std::cout << "   " << label << " x" << threads.size() << " threads took: "
+              << static_cast<long long>(seconds * 1000) << " ms, " << mops << " M alloc+free/s, checksum: "
+              << checksum << '\n';
+    return mops;
+}
+
+void runConcurrentBenchmark(size_t maxThreads, size_t totalOps, PagePolicy policy) {
+    std::cout << "\n🧵 Concurrent allocation, " << totalOps << " alloc/free pairs (up to " << maxThreads
+              << " threads)\n";
+
+    for (size_t count = 1;; count *= 2) {
+        count = std::min(count, maxThreads);
+        StaticThreadPool threads(count);
+        std::vector<PaddedChecksum> checksums(count);
+        size_t capacity = count * (LIVE_PER_THREAD + RING_CAPACITY + 4 * ConcurrentObjectPool<Trade>::MAGAZINE_SIZE);
+
+        std::cout << "\n " << count << " threads – symmetric churn:\n";
+        size_t perThread = totalOps / count;
+        double heapSym = timeThreads(threads, "❌ Heap", perThread * count, checksums, [&](size_t t) {
+            HeapHandle heap;
+            checksums[t].value = symmetricWorker(heap, perThread, 42 + t);
+        });
+        double poolSym;
+        {
+            ConcurrentObjectPool<Trade> pool(capacity, policy);
+            poolSym = timeThreads(threads, "✅ Pool", perThread * count, checksums, [&](size_t t) {
+                PoolHandle handle(pool);
+                checksums[t].value = symmetricWorker(handle, perThread, 42 + t);
+            });
+        }
+        std::cout << "   → pool/heap: " << poolSym / heapSym << "x\n";
+
+        // One thread can't be both ends of a blocking ring, so this starts at 2.
+        if (count >= 2) {
+            size_t pairs = count / 2;
+            size_t perProducer = totalOps / pairs;
+            std::vector<TradeRing> rings(pairs);
+            std::cout << "\n " << pairs * 2 << " threads – producer/consumer (" << pairs << " pairs):\n";
+
+            auto pipeline = [&](auto& handle, size_t t) {
+                if (t >= pairs * 2) return;
+                TradeRing& ring = rings[t / 2];
+                checksums[t].value = t % 2 == 0 ? producerWorker(handle, ring, perProducer)
+                                                : consumerWorker(handle, ring, perProducer);
+            };
+            double heapPc = timeThreads(threads, "❌ Heap", perProducer * pairs, checksums, [&](size_t t) {
+                HeapHandle heap;
+                pipeline(heap, t);
+            });
+            double poolPc;
+            {
+                ConcurrentObjectPool<Trade> pool(capacity, policy);
+                poolPc = timeThreads(threads, "✅ Pool", perProducer * pairs, checksums, [&](size_t t) {
+                    PoolHandle handle(pool);
+                    pipeline(handle, t);
+                });
+            }
+            std::cout << "   → pool/heap: " << poolPc / heapPc << "x\n";
+        }
+
+        if (count == maxThreads) break;
+    }
+}
@@ -0,0 +1,25 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – MULTI-THREADED ALLOCATION
+// ---------------------------------------------------------
+
+/*
+   Trades are allocated on the feed-handler thread and freed on the
+   strategy thread. This mode compares new/delete with
+   ConcurrentObjectPool (concurrent_pool.hpp) at 1, 2, 4 ... N threads
+   (./heap_vs_pool --mode=concurrent [--threads=N] [--ops=N]):
+
+   - symmetric         : every thread churns its own live set of trades
+   - producer/consumer : threads in pairs; one allocates and passes the
+                         pointer through an SPSC ring, the other reads and
+                         frees it – every free is a cross-thread free
+
+   The total work is fixed, so the aggregate Mops/s shows the scaling.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+void runConcurrentBenchmark(size_t maxThreads, size_t totalOps, PagePolicy policy);
@@ -0,0 +1,199 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – ConcurrentObjectPool<T>
+// ---------------------------------------------------------
+
+/*
+   A fixed-capacity pool that many threads allocate from and free to,
+   including freeing an object on a different thread than the one that
+   allocated it (feed handler → strategy).
+
+   - Thread caches (magazines): each thread owns a ThreadCache holding up
+     to 2 × MAGAZINE_SIZE free slots. allocate()/deallocate() only touch
+     that array – no atomics on the fast path.
+   - Global depot: when a cache runs dry it takes a whole batch of
+     MAGAZINE_SIZE slots from the depot; when it overflows it returns one.
+     The depot is a lock-free Treiber stack of batches (slots chained
+     through their own bytes), so one CAS moves MAGAZINE_SIZE slots.
+   - ABA safety: the depot head is a 64-bit word of 32-bit slot index +
+     32-bit tag; every successful CAS bumps the tag, so a head that was
+     popped and pushed back in between no longer compares equal.
+   - Cross-thread frees simply land in the freeing thread's cache and flow
+     back to the depot in batches, so producers refill from them.
+   - Fresh slots are carved MAGAZINE_SIZE at a time from one page-backed
+     block with an atomic bump index; when that and the depot are empty,
+     allocate() throws std::bad_alloc. Capacity is fixed at construction.
+
+       ConcurrentObjectPool<Trade> pool(1'000'000);
+       auto cache = pool.threadCache();          // one per thread
+       Trade* t = cache.create(1, 100.5, 10);
+       otherThreadCache.destroy(t);              // free anywhere
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "huge_pages.hpp"
+
+template<typename T>
+class ConcurrentObjectPool {
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    union Slot {
+        struct {
+            uint32_t nextInBatch;
+            uint32_t nextBatch; // only meaningful on a batch's first slot
+        } link;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+public:
+    static constexpr size_t MAGAZINE_SIZE = 64;
+
+    class ThreadCache {
+    public:
+        explicit ThreadCache(ConcurrentObjectPool& pool) : pool_(&pool) {}
+        ~ThreadCache() { flush(); }
+
+        ThreadCache(const ThreadCache&) = delete;
+        ThreadCache& operator=(const ThreadCache&) = delete;
+        ThreadCache(ThreadCache&& other) noexcept
+            : pool_(other.pool_), count_(std::exchange(other.count_, 0)) {
+            std::copy(other.slots_, other.slots_ + count_, slots_);
+        }
+
+        void* allocate() {
+            if (count_ == 0) refill();
+            return pool_->slotAt(slots_[--count_]);
+        }
+
+        void deallocate(void* p) {
+            if (p == nullptr) return;
+            if (count_ == 2 * MAGAZINE_SIZE) spill();
+            slots_[count_++] = pool_->indexOf(p);
+        }
+
+        template<typename... Args>
+        T* create(Args&&... args) {
+            void* p = allocate();
+            try {
+                return new (p) T{std::forward<Args>(args)...};
+            } catch (...) {
+                deallocate(p);
+                throw;
+            }
+        }
+
+        void destroy(T* object) {
+            if (object == nullptr) return;
+            object->~T();
+            deallocate(object);
+        }
+
+        // Returns every cached slot to the depot (also done by the destructor).
+        void flush() {
+            while (count_ >= MAGAZINE_SIZE) spill();
+            if (count_ > 0) pushBatch(slots_, count_);
+            count_ = 0;
+        }
+
+    private:
+        void refill() {
+            count_ = pool_->popBatch(slots_);
+            if (count_ == 0) count_ = pool_->carveFresh(slots_);
+            if (count_ == 0) throw std::bad_alloc();
+        }
+
+        // Hands the oldest MAGAZINE_SIZE cached slots to the depot.
+        void spill() {
+            pushBatch(slots_, MAGAZINE_SIZE);
+            std::copy(slots_ + MAGAZINE_SIZE, slots_ + count_, slots_);
+            count_ -= MAGAZINE_SIZE;
+        }
+
+        void pushBatch(const uint32_t* indices, size_t n) {
+            for (size_t i = 0; i + 1 < n; ++i) pool_->slotAt(indices[i])->link.nextInBatch = indices[i + 1];
+            pool_->slotAt(indices[n - 1])->link.nextInBatch = NONE;
+            pool_->pushBatch(indices[0]);
+        }
+
+        ConcurrentObjectPool* pool_;
+        size_t count_ = 0;
+        uint32_t slots_[2 * MAGAZINE_SIZE];
+    };
+
+    ConcurrentObjectPool(size_t capacity, PagePolicy policy = PagePolicy::Small4K)
+        : capacity_(capacity), policy_(policy) {
+        if (capacity >= NONE) throw std::bad_alloc();
+        slots_ = static_cast<Slot*>(allocatePages(capacity * sizeof(Slot), policy));
+        if (slots_ == nullptr) throw std::bad_alloc();
+    }
+
+    ~ConcurrentObjectPool() { freePages(slots_, capacity_ * sizeof(Slot), policy_); }
+
+    ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+    ThreadCache threadCache() { return ThreadCache(*this); }
+
+    size_t capacity() const { return capacity_; }
+    // Slots ever handed to a thread cache (the pool's high-water mark).
+    size_t carved() const { return std::min(nextFresh_.load(std::memory_order_relaxed), capacity_); }
+
+private:
+    static uint64_t pack(uint32_t index, uint32_t tag) { return uint64_t(tag) << 32 | index; }
+    static uint32_t headIndex(uint64_t head) { return static_cast<uint32_t>(head); }
+    static uint32_t headTag(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+
+    Slot* slotAt(uint32_t index) { return &slots_[index]; }
+    uint32_t indexOf(void* p) const { return static_cast<uint32_t>(static_cast<Slot*>(p) - slots_); }
+
+    // The batch link is read while another thread may pop (and reuse) the same
+    // slot; the tag check then fails the CAS, so access it through atomic_ref.
+    std::atomic_ref<uint32_t> nextBatchOf(uint32_t index) { return std::atomic_ref(slots_[index].link.nextBatch); }
+
+    void pushBatch(uint32_t first) {
+        uint64_t head = depot_.load(std::memory_order_relaxed);
+        do {
+            nextBatchOf(first).store(headIndex(head), std::memory_order_relaxed);
+        } while (!depot_.compare_exchange_weak(head, pack(first, headTag(head) + 1),
+                                               std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Pops one batch into `out`; returns how many slots it held (0 if the depot is empty).
+    size_t popBatch(uint32_t* out) {
+        uint64_t head = depot_.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t first = headIndex(head);
+            if (first == NONE) return 0;
+            uint32_t next = nextBatchOf(first).load(std::memory_order_relaxed);
+            if (depot_.compare_exchange_weak(head, pack(next, headTag(head) + 1),
+                                             std::memory_order_acquire, std::memory_order_acquire)) {
+                break;
+            }
+        }
+
+        size_t n = 0;
+        for (uint32_t i = headIndex(head); i != NONE; i = slots_[i].link.nextInBatch) out[n++] = i;
+        return n;
+    }
+
+    size_t carveFresh(uint32_t* out) {
+        size_t begin = nextFresh_.fetch_add(MAGAZINE_SIZE, std::memory_order_relaxed);
+        if (begin >= capacity_) return 0;
+        size_t end = std::min(begin + MAGAZINE_SIZE, capacity_);
+        for (size_t i = begin; i < end; ++i) out[i - begin] = static_cast<uint32_t>(i);
+        return end - begin;
+    }
+
+    size_t capacity_;
+    PagePolicy policy_;
+    Slot* slots_ = nullptr;
+    alignas(64) std::atomic<uint64_t> depot_{pack(NONE, 0)};
+    alignas(64) std::atomic<size_t> nextFresh_{0};
+};
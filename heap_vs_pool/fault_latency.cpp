@@ -0,0 +1,146 @@
+#include "fault_latency.hpp"
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "object_pool.hpp"
+#include "trade.hpp"
+
+constexpr size_t FAULT_BATCH = 256;
+constexpr long long SPIKE_NS = 1000;
+constexpr size_t HISTOGRAM_BUCKETS = 8; // < 64 ns, then ×4 per bucket; the last is ≥ 256 µs
+
+struct LatencyProfile {
+    std::array<size_t, HISTOGRAM_BUCKETS> histogram{};
+    std::vector<uint32_t> samples; // one per allocation, for percentiles
+    long long minorFaults = 0;
+    long long majorFaults = 0;
+    size_t spikes = 0;
+    size_t spikesInFaultingBatches = 0;
+    size_t faultingBatches = 0;
+    size_t batches = 0;
+};
+
+size_t bucketOf(long long ns) {
+    size_t bucket = 0;
+    for (long long limit = 64; bucket + 1 < HISTOGRAM_BUCKETS && ns >= limit; limit *= 4) ++bucket;
+    return bucket;
+}
+
+struct FaultCount {
+    long long minor;
+    long long major;
+};
+
+FaultCount faultsNow() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return {usage.ru_minflt, usage.ru_majflt};
+}
+
+// Times `count` calls of make(i) into `out`, one histogram entry each.
+template<typename Make>
+LatencyProfile profileAllocations(std::vector<Trade*>& out, size_t count, Make make) {
+    LatencyProfile profile;
+    profile.samples.reserve(count);
+
+    for (size_t begin = 0; begin < count; begin += FAULT_BATCH) {
+        size_t end = std::min(count, begin + FAULT_BATCH);
+        size_t spikes = 0;
+        FaultCount before = faultsNow();
+        for (size_t i = begin; i < end; ++i) {
+            auto start = std::chrono::high_resolution_clock::now();
+            out[i] = make(static_cast<int>(i));
+            auto stop = std::chrono::high_resolution_clock::now();
+            long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+            profile.samples.push_back(static_cast<uint32_t>(std::min<long long>(ns, UINT32_MAX)));
+            ++profile.histogram[bucketOf(ns)];
+            if (ns >= SPIKE_NS) ++spikes;
+        }
+        FaultCount after = faultsNow();
+
+        long long faults = (after.minor - before.minor) + (after.major - before.major);
+        profile.minorFaults += after.minor - before.minor;
+        profile.majorFaults += after.major - before.major;
+        profile.spikes += spikes;
+        ++profile.batches;
+        if (faults > 0) {
+            ++profile.faultingBatches;
+            profile.spikesInFaultingBatches += spikes;
+        }
+    }
+    std::sort(profile.samples.begin(), profile.samples.end());
+    return profile;
+}
+
+double percentileOf(const std::vector<uint32_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+// setw counts bytes; pad UTF-8 text (µ, ≥) by code points instead.
+std::string padded(const std::string& text, size_t width, bool left) {
+    size_t codePoints = 0;
+    for (unsigned char c : text) codePoints += (c & 0xC0) != 0x80;
+    std::string pad(codePoints < width ? width - codePoints : 1, ' ');
+    return left ? text + pad : pad + text;
+}
+
+void printHeader() {
+    std::cout << "   " << padded("allocator", 24, true) << padded("round", 6, true);
+    for (const char* label : {"<64ns", "<256ns", "<1µs", "<4µs", "<16µs", "<64µs", "<256µs", "≥256µs"}) {
+        std::cout << padded(label, 9, false);
+    }
+    std::cout << padded("p99 ns", 9, false) << padded("p99.9 ns", 10, false) << padded("max µs", 9, false)
+              << padded("faults", 9, false) << padded("spikes (in faulting batches)", 30, false) << "\n";
+}
+
+void printProfile(const std::string& name, const char* round, const LatencyProfile& p) {
+    std::cout << "   " << padded(name, 24, true) << padded(round, 6, true) << std::right;
+    for (size_t count : p.histogram) std::cout << std::setw(9) << count;
+    std::cout << std::setw(9) << static_cast<long long>(percentileOf(p.samples, 0.99)) << std::setw(10)
+              << static_cast<long long>(percentileOf(p.samples, 0.999)) << std::setw(9)
+              << (p.samples.empty() ? 0 : p.samples.back() / 1000) << std::setw(9) << p.minorFaults + p.majorFaults
+              << padded(std::to_string(p.spikes) + " (" + std::to_string(p.spikesInFaultingBatches) + ")", 30, false);
+    if (p.majorFaults > 0) std::cout << ", " << p.majorFaults << " major";
+    std::cout << "\n";
+}
+
+// Cold round, free everything, warm round, free everything.
+template<typename Make, typename Drop>
+void profileRounds(const std::string& name, size_t ops, Make make, Drop drop) {
+    std::vector<Trade*> trades(ops); // value-initialised, so its own pages are faulted before timing
+    for (const char* round : {"cold", "warm"}) {
+        LatencyProfile profile = profileAllocations(trades, ops, make);
+        for (Trade* t : trades) drop(t);
+        printProfile(name, round, profile);
+    }
+}
+
+void runFaultLatencyBenchmark(size_t ops, PagePolicy policy) {
+    ops = std::max<size_t>(1, ops);
+    std::cout << "\n⏱️ Per-allocation latency, " << ops << " trades per round (pools on " << pagePolicyName(policy)
+              << "), fault counts from getrusage per " << FAULT_BATCH << " allocations, spike = ≥" << SPIKE_NS
+              << " ns:\n";
+    printHeader();
+
+    profileRounds("new/delete", ops, [](int id) { return new Trade{id, 100.5 + id, 10}; },
+                  [](Trade* t) { delete t; });
+
+    for (const char* kind : {"lazy", "prefaulted", "prefaulted+mlock"}) {
+        std::string name = std::string(kind) + " pool";
+        ObjectPool<Trade> pool(ops, policy); // one chunk holds every trade
+        if (kind[0] == 'p' && !pool.prefault(std::string(kind).find("mlock") != std::string::npos)) {
+            name += " (no mlock)";
+        }
+        profileRounds(name, ops, [&](int id) { return pool.create(id, 100.5 + id, 10); },
+                      [&](Trade* t) { pool.destroy(t); });
+    }
+}
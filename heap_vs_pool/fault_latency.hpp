@@ -0,0 +1,32 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – TAIL LATENCY AND PAGE FAULTS
+// ---------------------------------------------------------
+
+/*
+   A mean over millions of allocations hides the few that stall on brk,
+   mmap or a first-touch page fault. This mode times every allocation
+   (plus the constructor's first write, which is where a lazy page
+   faults) into a log-scale histogram, in two rounds:
+   - cold : a fresh allocator grows to --ops live trades
+   - warm : everything is freed and allocated again
+   on new/delete, a lazily faulted ObjectPool, a pool pre-faulted at
+   startup (ObjectPool::prefault(), i.e. MADV_POPULATE_WRITE) and one that
+   is also mlock()ed.
+
+   Faults are read with getrusage(RUSAGE_SELF) once per batch of
+   FAULT_BATCH allocations (outside the timed region). Each slow
+   allocation (>= SPIKE_NS) is attributed to its batch, so the report
+   shows how many spikes fell in batches that took a fault and how many in
+   batches that did not. Major faults only show up when the machine is
+   short of memory and paging.
+
+   ./heap_vs_pool --mode=faults [--ops=N] [--pages=4k|thp|2m|1g]
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+void runFaultLatencyBenchmark(size_t ops, PagePolicy policy);
@@ -0,0 +1,164 @@
+#include "fragmentation.hpp"
+
+#include <malloc.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "allocator_backend.hpp"
+
+constexpr size_t RESIDENT_DIVISOR = 10;         // resident set = maxLive / 10, trough = maxLive / 10
+constexpr unsigned RESIDENT_REPLACE_PERCENT = 2; // chance per step that one resident is replaced
+constexpr size_t TOUCH_BYTES = 64;
+constexpr double MB = 1024.0 * 1024.0;
+
+struct LiveObject {
+    void* p;
+    uint32_t size;
+};
+
+struct FragmentationSample {
+    size_t liveBytes;
+    BackendUsage usage;
+    long long rssGrowth;
+};
+
+uint32_t transientSize(std::mt19937_64& rng) {
+    return static_cast<uint32_t>(16 + rng() % 497);
+}
+
+uint32_t residentSize(std::mt19937_64& rng) {
+    return static_cast<uint32_t>(64 + rng() % 4033);
+}
+
+std::vector<FragmentationSample> churn(AllocatorBackend& backend, const FragmentationConfig& config) {
+    std::mt19937_64 rng(config.seed);
+    size_t residents = std::max<size_t>(1, config.maxLive / RESIDENT_DIVISOR);
+    size_t minLive = residents;
+    size_t period = std::max<size_t>(1, config.steps / config.samples);
+
+    // Bookkeeping is sized up front so it is part of the baseline, not the growth.
+    std::vector<LiveObject> transient, resident;
+    transient.reserve(config.maxLive + 1);
+    resident.reserve(residents);
+    std::vector<FragmentationSample> samples;
+    samples.reserve(config.samples);
+
+    long long rssBefore = residentBytes();
+    backend.prepare(1, config.maxLive + residents);
+    BackendUsage base = backend.usage();
+    size_t liveBytes = 0;
+
+    auto allocate = [&](uint32_t size) {
+        void* p = backend.allocate(size, 0);
+        std::memset(p, 0x5a, std::min<size_t>(size, TOUCH_BYTES));
+        liveBytes += size;
+        return LiveObject{p, size};
+    };
+    auto release = [&](LiveObject o) {
+        backend.deallocate(o.p, o.size, 0);
+        liveBytes -= o.size;
+    };
+
+    for (size_t i = 0; i < residents; ++i) resident.push_back(allocate(residentSize(rng)));
+
+    for (size_t step = 0; step < config.steps; ++step) {
+        // Triangle wave: trough at the start and end of each cycle, peak in the middle.
+        double phase = static_cast<double>(step % period) / period;
+        size_t target = minLive + static_cast<size_t>((config.maxLive - minLive) * (1 - std::abs(2 * phase - 1)));
+
+        if (rng() % 100 < RESIDENT_REPLACE_PERCENT) {
+            LiveObject& victim = resident[rng() % resident.size()];
+            release(victim);
+            victim = allocate(residentSize(rng));
+        }
+        if (transient.size() < target) {
+            transient.push_back(allocate(transientSize(rng)));
+        } else if (!transient.empty()) {
+            // Random victim, so lifetimes are random rather than FIFO or LIFO.
+            LiveObject& victim = transient[rng() % transient.size()];
+            release(victim);
+            victim = transient.back();
+            transient.pop_back();
+        }
+
+        if ((step + 1) % period == 0 && samples.size() < config.samples) {
+            BackendUsage now = backend.usage();
+            if (now.known) {
+                now.heldBytes -= std::min(now.heldBytes, base.heldBytes);
+                now.handedOutBytes -= std::min(now.handedOutBytes, base.handedOutBytes);
+            }
+            samples.push_back({liveBytes, now, residentBytes() - rssBefore});
+        }
+    }
+
+    for (LiveObject o : transient) release(o);
+    for (LiveObject o : resident) release(o);
+    backend.threadDone(0);
+    return samples;
+}
+
+void printSamples(const char* name, const std::vector<FragmentationSample>& samples) {
+    std::cout << "\n   " << name << "\n   " << std::setw(6) << "cycle" << std::setw(11) << "live MB" << std::setw(12)
+              << "malloc'd MB" << std::setw(11) << "held MB" << std::setw(11) << "occupancy" << std::setw(8) << "frag"
+              << std::setw(10) << "RSS +MB" << "\n";
+    std::cout << std::fixed;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const FragmentationSample& s = samples[i];
+        std::cout << "   " << std::setw(6) << i + 1 << std::setprecision(1) << std::setw(11) << s.liveBytes / MB;
+        // frag only covers what the backend served itself; fall-through is malloc's business.
+        size_t served = s.liveBytes - std::min(s.liveBytes, s.usage.fallThroughBytes);
+        if (s.usage.known && s.usage.heldBytes > 0 && served > 0) {
+            std::cout << std::setw(12) << s.usage.fallThroughBytes / MB << std::setw(11) << s.usage.heldBytes / MB
+                      << std::setw(10) << 100.0 * s.usage.handedOutBytes / s.usage.heldBytes << "%"
+                      << std::setprecision(2) << std::setw(8) << static_cast<double>(s.usage.heldBytes) / served;
+        } else {
+            std::cout << std::setw(12) << "n/a" << std::setw(11) << "n/a" << std::setw(11) << "n/a" << std::setw(8)
+                      << "n/a";
+        }
+        std::cout << std::setprecision(1) << std::setw(10) << s.rssGrowth / MB << "\n";
+    }
+
+    const FragmentationSample& first = samples.front();
+    const FragmentationSample& last = samples.back();
+    if (first.usage.known && first.usage.heldBytes > 0) {
+        std::cout << "   growth: held " << first.usage.heldBytes / MB << " MB → " << last.usage.heldBytes / MB
+                  << " MB (" << std::showpos
+                  << 100.0 * (static_cast<double>(last.usage.heldBytes) / first.usage.heldBytes - 1) << "%"
+                  << std::noshowpos << ")";
+    } else {
+        std::cout << "   growth:";
+    }
+    std::cout << ", RSS " << first.rssGrowth / MB << " MB → " << last.rssGrowth / MB << " MB\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+void runFragmentationBenchmark(const std::vector<std::string>& allocators, const FragmentationConfig& config,
+                               PagePolicy policy) {
+    FragmentationConfig c = config;
+    c.steps = std::max<size_t>(1, c.steps);
+    c.samples = std::max<size_t>(1, std::min(c.samples, c.steps));
+    c.maxLive = std::max<size_t>(RESIDENT_DIVISOR, c.maxLive);
+
+    std::cout << "\n🧩 Fragmentation churn: " << c.steps << " steps, " << c.samples << " cycles, transient live set "
+              << c.maxLive / RESIDENT_DIVISOR << "-" << c.maxLive << " objects over " << c.maxLive / RESIDENT_DIVISOR
+              << " residents; sampled at each trough\n";
+
+    for (const std::string& name : allocators) {
+        std::vector<FragmentationSample> samples;
+        std::string label;
+        {
+            std::unique_ptr<AllocatorBackend> backend = makeBackend(name, policy);
+            label = backend->name();
+            samples = churn(*backend, c);
+        }
+        // Hand glibc's free memory back so the next backend starts from the same RSS.
+        malloc_trim(0);
+        printSamples(label.c_str(), samples);
+    }
+}
@@ -0,0 +1,54 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – FRAGMENTATION UNDER LONG-RUNNING CHURN
+// ---------------------------------------------------------
+
+/*
+   A trading day compressed into a loop: the transient live set (orders,
+   messages, 16-512 B) swells to --live objects and drains back to a tenth
+   of it once per cycle, while a resident set (books, sessions, 64 B-4 KB)
+   is replaced slowly underneath. Residents allocated during a swell land
+   between transients and pin their pages once the transients drain –
+   the pattern that makes a heap grow for hours at constant live data.
+
+   At the end of every cycle (a trough, so the live set is the same size
+   each time) the benchmark samples:
+   - live      : bytes the program asked for and has not freed
+   - malloc'd  : the part of live a backend passed on to malloc (the pool
+                 serves only 256-byte blocks, arena and sizeclass up to
+                 4 KB); always 0 for malloc itself
+   - held      : bytes the allocator keeps (AllocatorBackend::usage();
+                 mallinfo2() for malloc, carved pages for the others),
+                 not counting what it passed on
+   - occupancy : handed-out / held, how full the allocator's memory is
+   - frag      : held / (live - malloc'd), 1.0 = no overhead at all
+
+   A backend's frag therefore describes only the objects it served. With
+   most residents and the larger transients falling through, the pool's
+   frag is not comparable with malloc's row; RSS +MB is the figure that
+   covers everything.
+   - RSS       : resident set growth from /proc/self/statm since the start
+
+   Growth is the held size at the last trough over the first: a flat line
+   means memory is reused, a rising one is what pages you at 3 pm.
+   Every backend replays the same seeded sequence on one thread.
+
+   ./heap_vs_pool --mode=fragmentation [--steps=N] [--live=N] [--samples=N]
+                  [--allocator=NAME[,NAME...]|all] [--allocator-lib=PATH]
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+struct FragmentationConfig {
+    size_t steps = 10'000'000;
+    size_t maxLive = 200'000; // transient objects at the top of a cycle
+    size_t samples = 10;      // one per cycle
+    uint64_t seed = 42;
+};
+
+void runFragmentationBenchmark(const std::vector<std::string>& allocators, const FragmentationConfig& config,
+                               PagePolicy policy);
@@ -50,23 +50,172 @@
      ✅ Predictable performance
 */
 
+
+// 5. WHAT ABOUT PAGE SIZE?
+/*
+   - The pool is one big block, so it can be backed by huge pages
+     (--pages=thp|2m|1g) and its objects then share a handful of TLB entries.
+   - The heap path stays on whatever glibc hands out; to try THP there,
+     run with GLIBC_TUNABLES=glibc.malloc.hugetlb=1 instead.
+   - dTLB misses are printed next to each timing.
+*/
+
+
+// 6. ISN'T THAT AN ARENA RATHER THAN A POOL?
+/*
+   Yes – the benchmark above bump-allocates one big array and never frees or
+   reuses a single object. A real pool (object_pool.hpp) hands freed slots
+   back out through an intrusive free list and grows chunk by chunk.
+   Allocate-all-then-free-all flatters any allocator, so the pool is
+   compared with new/delete on interleaved patterns instead:
+   - churn : a fixed live set; each step frees a random trade and makes a new one
+   - fifo  : bursts of 1-256 allocations, the oldest trades freed in bursts
+   - lifo  : short-lived temporaries, freed in reverse order within a few steps
+   Run one pattern with --pattern=churn|fifo|lifo, or all by default.
+   Every pattern (locality and message included) also runs on each
+   AllocatorBackend of section 9, picked with --allocator as in the trace
+   replay.
+
+   Allocation speed is only half of the claim in section 2; the other half
+   is that pooled objects stay close together. --pattern=locality churns
+   a large live set of trades (with the rest of the program's messages
+   still coming from malloc in between), then walks the surviving Trade*
+   in vector order as a strategy would, and times that walk with L1/LLC
+   misses and the number of distinct cache lines and pages it touches.
+
+   Many allocations live for exactly one market-data message. For those
+   the bump arena of section 3 comes back as Arena (arena.hpp): chunks
+   chained on demand, any alignment, and a Scope that rewinds everything
+   a message allocated in one store. --pattern=message handles simulated
+   messages with 2-8 variable-sized temporaries (some 64-byte aligned)
+   plus a scratch buffer released mid-message with mark()/rewind(), and
+   compares malloc/free and the size-class pool per object with an arena
+   reset per message.
+*/
+
+
+// 7. WHAT ABOUT MORE THAN ONE THREAD?
+/*
+   In production the feed handler allocates and the strategy thread frees.
+   --mode=concurrent runs symmetric and producer/consumer patterns on 1..N
+   threads against a pool with per-thread magazines and a lock-free global
+   depot (concurrent_pool.hpp, concurrent_benchmark.cpp).
+*/
+
+
+// 8. CAN WE REPLAY WHAT PRODUCTION DOES?
+/*
+   --mode=trace replays allocation/free events (size, thread, lifetime)
+   from a captured trace file (--trace=FILE) or from synthetic churn,
+   producer/consumer and long-lived + transient generators, against any
+   AllocatorBackend (allocation_trace.hpp, trace_replay.hpp).
+*/
+
+
+// 9. HOW DOES THE POOL COMPARE WITH REAL GENERAL-PURPOSE ALLOCATORS?
+/*
+   The replay runs side by side on glibc malloc, an arena allocator in the
+   style of jemalloc (a locked arena per thread, frees routed back to the
+   owning arena through a block header), a size-class allocator in the
+   style of tcmalloc (unlocked thread caches over locked central lists,
+   sized frees) and the pool, reporting throughput, sampled p50/p99/p99.9
+   latency and RSS growth (allocator_backends.cpp).
+   Production allocators plug in without a rebuild: --allocator-lib=PATH
+   dlopens a library exporting malloc/free, or run the whole binary under
+   LD_PRELOAD=libjemalloc.so and read the 'malloc' row.
+*/
+
+
+// 10. DOES THE POOL REALLY AVOID FRAGMENTATION?
+/*
+   --mode=fragmentation runs hours of mixed-size churn with random
+   lifetimes in seconds and samples RSS, mallinfo2() and each backend's
+   own occupancy once per cycle, reporting the held/live fragmentation
+   ratio and how the footprint grows at constant live data
+   (fragmentation.hpp).
+*/
+
+
+// 11. DOES IT WORK WITH STL CONTAINERS?
+/*
+   Only through std::pmr. PoolResource (pool_resource.hpp) is a
+   memory_resource over one ObjectPool per size class, and --mode=pmr runs
+   pmr vector, unordered_map and list workloads on it, on the default
+   heap, on monotonic_buffer_resource and on unsynchronized_pool_resource
+   (pmr_benchmark.hpp).
+*/
+
+
+// 12. WHAT DOES THE MEAN HIDE?
+/*
+   The rare allocation that waits for brk/mmap or a first-touch page
+   fault. --mode=faults records every allocation's latency in a histogram
+   next to getrusage() fault counts, for new/delete, a lazily faulted pool
+   and pools pre-faulted (and mlock()ed) at startup (fault_latency.hpp).
+*/
+
+
+// 13. AND MESSAGES THAT ARE NOT ALL THE SAME SIZE?
+/*
+   Trade is fixed-size, market-data messages are 32-1500 bytes.
+   SlabAllocator (slab_allocator.hpp) gives each size class its own
+   size-aligned slabs with a free bitmap; --mode=slab churns
+   messages drawn from a configurable size histogram on it and on malloc,
+   and reports the internal-fragmentation waste of each class layout next
+   to its speed (slab_benchmark.hpp).
+*/
+
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <vector>
 #include <cstdlib>
 #include <cstring>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <stdexcept>
 
-constexpr size_t NUM_OBJECTS = 10'000'000;
+#include "allocation_trace.hpp"
+#include "allocator_backend.hpp"
+#include "arena.hpp"
+#include "bench_options.hpp"
+#include "concurrent_benchmark.hpp"
+#include "fast_random.hpp"
+#include "fault_latency.hpp"
+#include "fragmentation.hpp"
+#include "huge_pages.hpp"
+#include "object_pool.hpp"
+#include "perf_counters.hpp"
+#include "pmr_benchmark.hpp"
+#include "pool_resource.hpp"
+#include "slab_benchmark.hpp"
+#include "thread_affinity.hpp"
+#include "trace_replay.hpp"
+#include "trade.hpp"
 
-struct Trade {
-    int id;
-    double price;
-    int quantity;
-};
+constexpr size_t NUM_OBJECTS = 10'000'000;
+constexpr size_t TRACE_ALLOCATIONS = 1'000'000;
+constexpr size_t LIVE_TRADES = 100'000;
+constexpr size_t MAX_BURST = 256;
+constexpr size_t MAX_TEMPORARIES = 8;
+constexpr size_t LOCALITY_LIVE_TRADES = 1'000'000;
+constexpr size_t LOCALITY_PASSES = 10;
+constexpr size_t NOISE_LIVE = 64; // in-flight messages allocated between trades
+constexpr size_t CHURN_BATCH = 64; // trades freed together before their replacements are made
+constexpr size_t NUM_MESSAGES = 1'000'000;
+constexpr size_t MAX_MESSAGE_TEMPORARIES = 8;
+constexpr size_t MAX_TEMPORARY_BYTES = 1024;
+constexpr size_t SCRATCH_BYTES = 256;
+constexpr size_t CACHE_LINE = 64;
 
 // Heap Allocation Benchmark
 
 void heapAllocationBenchmark() {
+    PerfCounter dtlbMisses(PerfEvent::DtlbLoadMisses);
+
+    dtlbMisses.start();
     auto start = std::chrono::high_resolution_clock::now();
 
     std::vector<Trade*> trades;
@@ -77,18 +226,23 @@ void heapAllocationBenchmark() {
     for (auto t : trades) delete t;
 
     auto end = std::chrono::high_resolution_clock::now();
+    long long misses = dtlbMisses.stop();
     std::cout << "❌ Heap Allocation took: "
               << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
-              << " ms\n";
+              << " ms, dTLB misses: " << formatCount(misses) << "\n";
 }
 
 
 // Memory Pool Benchmark
 
-void poolAllocationBenchmark() {
+void poolAllocationBenchmark(PagePolicy policy) {
+    PerfCounter dtlbMisses(PerfEvent::DtlbLoadMisses);
+
+    dtlbMisses.start();
     auto start = std::chrono::high_resolution_clock::now();
 
-    void* memory = std::malloc(sizeof(Trade) * NUM_OBJECTS);
+    void* memory = allocatePages(sizeof(Trade) * NUM_OBJECTS, policy);
+    if (memory == nullptr) return;
     Trade* trades = static_cast<Trade*>(memory);
 
     for (size_t i = 0; i < NUM_OBJECTS; ++i) {
@@ -100,17 +254,508 @@ void poolAllocationBenchmark() {
         trades[i].~Trade(); // Manually call destructor
     }
 
-    std::free(memory);
+    freePages(memory, sizeof(Trade) * NUM_OBJECTS, policy);
 
     auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "✅ Pool Allocation took: "
+    long long misses = dtlbMisses.stop();
+    std::cout << "✅ Arena (bump) Allocation took: "
               << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
-              << " ms\n";
+              << " ms, dTLB misses: " << formatCount(misses) << "\n";
+}
+
+// Interleaved Alloc/Free Patterns
+
+struct HeapTrades {
+    Trade* make(int id) { return new Trade{id, 100.5 + id, 10}; }
+    void drop(Trade* t) { delete t; }
+};
+
+struct PoolTrades {
+    ObjectPool<Trade> pool;
+
+    explicit PoolTrades(PagePolicy policy) : pool(ObjectPool<Trade>::DEFAULT_CHUNK_SIZE, policy) {}
+    Trade* make(int id) { return pool.create(id, 100.5 + id, 10); }
+    void drop(Trade* t) { pool.destroy(t); }
+};
+
+// Any AllocatorBackend, driven from this one thread. `maxLive` bounds the
+// live trades, for backends that size themselves in prepare().
+struct BackendTrades {
+    AllocatorBackend& backend;
+
+    BackendTrades(AllocatorBackend& b, size_t maxLive) : backend(b) { backend.prepare(1, maxLive); }
+    Trade* make(int id) { return new (backend.allocate(sizeof(Trade), 0)) Trade{id, 100.5 + id, 10}; }
+    void drop(Trade* t) {
+        t->~Trade();
+        backend.deallocate(t, sizeof(Trade), 0);
+    }
+};
+
+// Each pattern performs `ops` allocations (and as many frees) and returns a checksum.
+template<typename Allocator>
+long long churnPattern(Allocator& alloc, size_t ops) {
+    std::vector<Trade*> live(LIVE_TRADES);
+    for (size_t i = 0; i < LIVE_TRADES; ++i) live[i] = alloc.make(static_cast<int>(i));
+
+    FastRandom rng(42);
+    long long checksum = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        Trade*& victim = live[rng.below(LIVE_TRADES)];
+        checksum += victim->id;
+        alloc.drop(victim);
+        victim = alloc.make(static_cast<int>(i));
+    }
+    for (Trade* t : live) alloc.drop(t);
+    return checksum;
+}
+
+template<typename Allocator>
+long long fifoPattern(Allocator& alloc, size_t ops) {
+    // Ring buffer of in-flight trades: allocate at the head, free from the tail.
+    std::vector<Trade*> ring(LIVE_TRADES);
+    size_t head = 0, tail = 0, inFlight = 0;
+
+    FastRandom rng(42);
+    long long checksum = 0;
+    for (size_t made = 0; made < ops;) {
+        size_t burst = 1 + rng.below(MAX_BURST);
+        for (size_t k = 0; k < burst && inFlight < LIVE_TRADES && made < ops; ++k, ++made, ++inFlight) {
+            ring[head] = alloc.make(static_cast<int>(made));
+            head = (head + 1) % LIVE_TRADES;
+        }
+        size_t drain = 1 + rng.below(MAX_BURST);
+        for (size_t k = 0; k < drain && inFlight > 0; ++k, --inFlight) {
+            checksum += ring[tail]->id;
+            alloc.drop(ring[tail]);
+            tail = (tail + 1) % LIVE_TRADES;
+        }
+    }
+    for (; inFlight > 0; --inFlight, tail = (tail + 1) % LIVE_TRADES) alloc.drop(ring[tail]);
+    return checksum;
+}
+
+template<typename Allocator>
+long long lifoPattern(Allocator& alloc, size_t ops) {
+    Trade* stack[MAX_TEMPORARIES];
+
+    FastRandom rng(42);
+    long long checksum = 0;
+    for (size_t made = 0; made < ops;) {
+        size_t depth = 1 + rng.below(MAX_TEMPORARIES);
+        size_t n = 0;
+        for (; n < depth && made < ops; ++n, ++made) stack[n] = alloc.make(static_cast<int>(made));
+        while (n > 0) {
+            checksum += stack[--n]->quantity;
+            alloc.drop(stack[n]);
+        }
+    }
+    return checksum;
+}
+
+template<typename Pattern>
+void timePattern(const std::string& label, size_t ops, Pattern pattern) {
+    PerfCounter dtlbMisses(PerfEvent::DtlbLoadMisses);
+
+    dtlbMisses.start();
+    auto start = std::chrono::high_resolution_clock::now();
+    long long checksum = pattern();
+    auto end = std::chrono::high_resolution_clock::now();
+    long long misses = dtlbMisses.stop();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << label << " took: " << static_cast<long long>(ms) << " ms, " << ms * 1e6 / ops
+              << " ns/alloc+free, dTLB misses: " << formatCount(misses) << ", checksum: " << checksum << "\n";
+}
+
+template<typename Allocator>
+long long runPattern(const std::string& pattern, Allocator& alloc) {
+    if (pattern == "churn") return churnPattern(alloc, NUM_OBJECTS);
+    if (pattern == "fifo") return fifoPattern(alloc, NUM_OBJECTS);
+    return lifoPattern(alloc, NUM_OBJECTS);
+}
+
+void interleavedBenchmark(const std::string& pattern, const std::vector<std::string>& allocators, PagePolicy policy) {
+    std::cout << "\n🔁 " << pattern << " pattern, " << NUM_OBJECTS << " alloc/free pairs:\n";
+
+    HeapTrades heap;
+    PoolTrades pool(policy);
+    timePattern("❌ Heap " + pattern, NUM_OBJECTS, [&] { return runPattern(pattern, heap); });
+    timePattern("✅ Pool " + pattern, NUM_OBJECTS, [&] { return runPattern(pattern, pool); });
+    std::cout << "   pool grew to " << pool.pool.chunkCount() << " chunks (" << pool.pool.capacity()
+              << " slots of " << ObjectPool<Trade>::SLOT_SIZE << " bytes)\n";
+
+    for (const std::string& name : allocators) {
+        std::unique_ptr<AllocatorBackend> backend = makeBackend(name, policy);
+        BackendTrades trades(*backend, LIVE_TRADES);
+        timePattern("   " + std::string(backend->name()) + " " + pattern, NUM_OBJECTS,
+                    [&] { return runPattern(pattern, trades); });
+    }
 }
 
-int main() {
-    std::cout << "🚀 Comparing Heap vs Memory Pool Allocation...\n\n";
-    heapAllocationBenchmark();
-    poolAllocationBenchmark();
+// Locality After Churn
+
+// Malloc'd message sizes; half of them share glibc's 32-byte chunk class with
+// a 24-byte Trade, so the heap hands trades and messages the same chunks.
+size_t noiseSize(FastRandom& rng) {
+    return rng.below(2) == 0 ? 8 + rng.below(sizeof(Trade) - 7) : 32 + rng.below(481);
+}
+
+// Churns a live set of `live` trades for `ops` replacements and returns the survivors.
+// Replacements happen in batches of CHURN_BATCH distinct random victims: all
+// are freed, then new trades are made into the same slots in the same order,
+// so a LIFO free list hands each slot another victim's address. Every free
+// and every allocation is followed by a malloc'd message replacing the
+// oldest in-flight one, as the rest of the process would.
+template<typename Allocator>
+std::vector<Trade*> churnedTrades(Allocator& alloc, size_t live, size_t ops) {
+    std::vector<Trade*> trades(live);
+    std::vector<size_t> slots(live);
+    std::vector<void*> noise(NOISE_LIVE, nullptr);
+    size_t nextNoise = 0;
+    FastRandom rng(42);
+
+    auto message = [&] {
+        void*& oldest = noise[nextNoise++ % NOISE_LIVE];
+        std::free(oldest);
+        oldest = std::malloc(noiseSize(rng));
+    };
+
+    for (size_t i = 0; i < live; ++i) {
+        trades[i] = alloc.make(static_cast<int>(i));
+        slots[i] = i;
+    }
+    for (size_t done = 0; done < ops;) {
+        size_t batch = std::min({CHURN_BATCH, live, ops - done});
+        // Partial Fisher-Yates: slots[0..batch) become distinct random victims.
+        for (size_t k = 0; k < batch; ++k) std::swap(slots[k], slots[k + rng.below(live - k)]);
+        for (size_t k = 0; k < batch; ++k) {
+            alloc.drop(trades[slots[k]]);
+            message();
+        }
+        for (size_t k = 0; k < batch; ++k, ++done) {
+            trades[slots[k]] = alloc.make(static_cast<int>(done));
+            message();
+        }
+    }
+    for (void* m : noise) std::free(m);
+    return trades;
+}
+
+size_t distinctBlocks(const std::vector<Trade*>& trades, unsigned shift) {
+    std::vector<uintptr_t> blocks;
+    blocks.reserve(trades.size());
+    for (Trade* t : trades) blocks.push_back(reinterpret_cast<uintptr_t>(t) >> shift);
+    std::sort(blocks.begin(), blocks.end());
+    return std::unique(blocks.begin(), blocks.end()) - blocks.begin();
+}
+
+void timeTraversal(const std::string& label, const std::vector<Trade*>& trades) {
+    PerfCounter l1dMisses(PerfEvent::L1dLoadMisses);
+    PerfCounter llcMisses(PerfEvent::LlcLoadMisses);
+
+    double notional = 0;
+    l1dMisses.start();
+    llcMisses.start();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t pass = 0; pass < LOCALITY_PASSES; ++pass) {
+        for (const Trade* t : trades) notional += t->price * t->quantity;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    long long llc = llcMisses.stop();
+    long long l1d = l1dMisses.stop();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << label << " took: " << static_cast<long long>(ms) << " ms, "
+              << ms * 1e6 / (trades.size() * LOCALITY_PASSES) << " ns/trade, L1d misses: " << formatCount(l1d)
+              << ", LLC misses: " << formatCount(llc) << ", spans " << distinctBlocks(trades, 6) << " lines / "
+              << distinctBlocks(trades, 12) << " pages, notional: " << static_cast<long long>(notional) << "\n";
+}
+
+void localityBenchmark(const std::vector<std::string>& allocators, PagePolicy policy) {
+    std::cout << "\n🧭 locality: walk " << LOCALITY_LIVE_TRADES << " live trades " << LOCALITY_PASSES
+              << " times, fresh and after " << NUM_OBJECTS << " churn replacements:\n";
+
+    for (size_t ops : {size_t{0}, NUM_OBJECTS}) {
+        const char* when = ops == 0 ? "fresh" : "churned";
+        {
+            HeapTrades heap;
+            std::vector<Trade*> trades = churnedTrades(heap, LOCALITY_LIVE_TRADES, ops);
+            timeTraversal(std::string("❌ Heap walk, ") + when, trades);
+            for (Trade* t : trades) heap.drop(t);
+        }
+        {
+            PoolTrades pool(policy);
+            std::vector<Trade*> trades = churnedTrades(pool, LOCALITY_LIVE_TRADES, ops);
+            timeTraversal(std::string("✅ Pool walk, ") + when, trades);
+            for (Trade* t : trades) pool.drop(t);
+        }
+        for (const std::string& name : allocators) {
+            std::unique_ptr<AllocatorBackend> backend = makeBackend(name, policy);
+            BackendTrades backendTrades(*backend, LOCALITY_LIVE_TRADES);
+            std::vector<Trade*> trades = churnedTrades(backendTrades, LOCALITY_LIVE_TRADES, ops);
+            timeTraversal("   " + std::string(backend->name()) + " walk, " + when, trades);
+            for (Trade* t : trades) backendTrades.drop(t);
+        }
+    }
+}
+
+// Per-Message Temporaries
+
+struct Temporary {
+    size_t bytes;
+    size_t alignment;
+};
+
+// Same sizes and alignments for every allocator: 16..1024 bytes, one in four cache-line aligned.
+Temporary nextTemporary(FastRandom& rng) {
+    size_t bytes = 16 + rng.below(MAX_TEMPORARY_BYTES - 15);
+    return {bytes, rng.below(4) == 0 ? CACHE_LINE : alignof(std::max_align_t)};
+}
+
+// Stands in for decoding into a temporary.
+long long fill(void* p, size_t bytes, size_t message) {
+    std::memset(p, static_cast<int>(message), std::min(bytes, CACHE_LINE));
+    return static_cast<unsigned char*>(p)[0] + static_cast<long long>(bytes);
+}
+
+struct HeapTemporaries {
+    void* get(size_t bytes, size_t alignment) {
+        if (alignment <= alignof(std::max_align_t)) return std::malloc(bytes);
+        return std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+    }
+    void put(void* p, size_t, size_t) { std::free(p); }
+};
+
+struct PoolTemporaries {
+    PoolResource pool;
+
+    explicit PoolTemporaries(PagePolicy policy) : pool(policy) {}
+    void* get(size_t bytes, size_t alignment) { return pool.allocate(bytes, alignment); }
+    void put(void* p, size_t bytes, size_t alignment) { pool.deallocate(p, bytes, alignment); }
+};
+
+// Backends only promise malloc alignment, so over-aligned requests are
+// padded and the raw pointer is kept in the word just below the result.
+struct BackendTemporaries {
+    AllocatorBackend& backend;
+
+    explicit BackendTemporaries(AllocatorBackend& b) : backend(b) { backend.prepare(1, MAX_MESSAGE_TEMPORARIES + 1); }
+
+    void* get(size_t bytes, size_t alignment) {
+        if (alignment <= alignof(std::max_align_t)) return backend.allocate(bytes, 0);
+        auto raw = reinterpret_cast<uintptr_t>(backend.allocate(bytes + alignment, 0));
+        uintptr_t aligned = (raw + sizeof(void*) + alignment - 1) & ~(alignment - 1);
+        reinterpret_cast<uintptr_t*>(aligned)[-1] = raw;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void put(void* p, size_t bytes, size_t alignment) {
+        if (alignment <= alignof(std::max_align_t)) return backend.deallocate(p, bytes, 0);
+        backend.deallocate(reinterpret_cast<void*>(static_cast<uintptr_t*>(p)[-1]), bytes + alignment, 0);
+    }
+};
+
+// Every temporary is freed on its own, the scratch buffer as soon as it is done with.
+template<typename Allocator>
+long long messagePattern(Allocator& alloc, size_t messages) {
+    FastRandom rng(42);
+    long long checksum = 0;
+    for (size_t m = 0; m < messages; ++m) {
+        void* held[MAX_MESSAGE_TEMPORARIES];
+        Temporary shapes[MAX_MESSAGE_TEMPORARIES];
+        size_t n = 2 + rng.below(MAX_MESSAGE_TEMPORARIES - 1);
+        for (size_t i = 0; i < n; ++i) {
+            shapes[i] = nextTemporary(rng);
+            held[i] = alloc.get(shapes[i].bytes, shapes[i].alignment);
+            checksum += fill(held[i], shapes[i].bytes, m);
+        }
+        void* scratch = alloc.get(SCRATCH_BYTES, CACHE_LINE);
+        checksum += fill(scratch, SCRATCH_BYTES, m);
+        alloc.put(scratch, SCRATCH_BYTES, CACHE_LINE);
+        for (size_t i = 0; i < n; ++i) alloc.put(held[i], shapes[i].bytes, shapes[i].alignment);
+    }
+    return checksum;
+}
+
+// The same work with nothing freed: the scratch buffer is rewound, the message scope resets the rest.
+long long arenaMessagePattern(Arena& arena, size_t messages) {
+    FastRandom rng(42);
+    long long checksum = 0;
+    for (size_t m = 0; m < messages; ++m) {
+        Arena::Scope message(arena);
+        size_t n = 2 + rng.below(MAX_MESSAGE_TEMPORARIES - 1);
+        for (size_t i = 0; i < n; ++i) {
+            Temporary shape = nextTemporary(rng);
+            checksum += fill(arena.allocate(shape.bytes, shape.alignment), shape.bytes, m);
+        }
+        Arena::Marker beforeScratch = arena.mark();
+        checksum += fill(arena.allocate(SCRATCH_BYTES, CACHE_LINE), SCRATCH_BYTES, m);
+        arena.rewind(beforeScratch);
+    }
+    return checksum;
+}
+
+template<typename Pattern>
+void timeMessages(const std::string& label, Pattern pattern) {
+    auto start = std::chrono::high_resolution_clock::now();
+    long long checksum = pattern();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << label << " took: " << static_cast<long long>(ms) << " ms, " << ms * 1e6 / NUM_MESSAGES
+              << " ns/message, checksum: " << checksum << "\n";
+}
+
+void messageBenchmark(const std::vector<std::string>& allocators, PagePolicy policy) {
+    std::cout << "\n✉️ message pattern, " << NUM_MESSAGES << " messages of 2-" << MAX_MESSAGE_TEMPORARIES
+              << " temporaries + scratch:\n";
+
+    HeapTemporaries heap;
+    PoolTemporaries pool(policy);
+    Arena arena(Arena::DEFAULT_CHUNK_BYTES, policy);
+    timeMessages("❌ Heap per object", [&] { return messagePattern(heap, NUM_MESSAGES); });
+    timeMessages("   Pool per object", [&] { return messagePattern(pool, NUM_MESSAGES); });
+    timeMessages("✅ Arena per message", [&] { return arenaMessagePattern(arena, NUM_MESSAGES); });
+    std::cout << "   arena kept " << arena.chunkCount() << " chunk(s), " << arena.bytesReserved() / 1024
+              << " KB, and is back at " << arena.bytesUsed() << " bytes used\n";
+    for (const std::string& name : allocators) {
+        std::unique_ptr<AllocatorBackend> backend = makeBackend(name, policy);
+        BackendTemporaries temporaries(*backend);
+        timeMessages("   " + std::string(backend->name()) + " per object",
+                     [&] { return messagePattern(temporaries, NUM_MESSAGES); });
+    }
+}
+
+// Shows the debug pool catching a double free instead of corrupting its list.
+void doubleFreeCheck() {
+    ObjectPool<Trade, true> pool(1024);
+    Trade* t = pool.create(1, 100.5, 10);
+    pool.destroy(t);
+    try {
+        pool.deallocate(t);
+        std::cout << "\n❌ Debug pool missed a double free\n";
+    } catch (const std::logic_error& e) {
+        std::cout << "\n✅ Debug pool caught: " << e.what() << "\n";
+    }
+}
+
+// --allocator=NAME[,NAME...]|all plus --allocator-lib=PATH; every name is
+// checked before anything runs.
+std::vector<std::string> allocatorList(const BenchOptions& options, PagePolicy policy) {
+    std::vector<std::string> allocators;
+    std::string names = options.get("allocator", "all");
+    if (names == "all") {
+        allocators = backendNames();
+    } else {
+        for (size_t begin = 0, comma; begin <= names.size(); begin = comma + 1) {
+            comma = std::min(names.find(',', begin), names.size());
+            allocators.push_back(names.substr(begin, comma - begin));
+        }
+    }
+    if (options.has("allocator-lib")) allocators.push_back("lib:" + options.get("allocator-lib", ""));
+    for (const std::string& name : allocators) makeBackend(name, policy);
+    return allocators;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    PagePolicy policy;
+    try {
+        policy = parsePagePolicy(options.get("pages", "4k"));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::string mode = options.get("mode", "patterns");
+    size_t threads = std::max<size_t>(1, options.getSize("threads", std::max(2u, cpuCount())));
+    if (mode == "concurrent") {
+        runConcurrentBenchmark(threads, options.getSize("ops", NUM_OBJECTS), policy);
+        return 0;
+    }
+    if (mode == "trace") {
+        try {
+            std::vector<AllocationTrace> traces;
+            if (options.has("trace")) {
+                traces.push_back(loadTrace(options.get("trace", "")));
+            } else {
+                size_t allocations = options.getSize("events", TRACE_ALLOCATIONS);
+                std::string kind = options.get("trace-gen", "all");
+                for (const char* k : {"churn", "pc", "mixed"}) {
+                    if (kind == "all" || kind == k) traces.push_back(generateTrace(k, allocations, threads));
+                }
+                if (traces.empty()) traces.push_back(generateTrace(kind, allocations, threads));
+            }
+            if (options.has("save-trace")) saveTrace(traces.front(), options.get("save-trace", ""));
+            std::vector<std::string> allocators = allocatorList(options, policy);
+            for (const AllocationTrace& trace : traces) runTraceReplay(trace, allocators, policy);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (mode == "faults") {
+        runFaultLatencyBenchmark(options.getSize("ops", NUM_OBJECTS / 10), policy);
+        return 0;
+    }
+    if (mode == "slab") {
+        try {
+            runSlabBenchmark(options.get("sizes", DEFAULT_SIZE_HISTOGRAM), options.get("classes", "all"),
+                             options.getSize("ops", NUM_OBJECTS / 10), policy);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (mode == "pmr") {
+        runPmrBenchmark(options.getSize("ops", NUM_OBJECTS / 10), policy);
+        return 0;
+    }
+    if (mode == "fragmentation") {
+        try {
+            FragmentationConfig config;
+            config.steps = options.getSize("steps", config.steps);
+            config.maxLive = options.getSize("live", config.maxLive);
+            config.samples = options.getSize("samples", config.samples);
+            runFragmentationBenchmark(allocatorList(options, policy), config, policy);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    std::string pattern = options.get("pattern", "all");
+    if (pattern != "all" && pattern != "churn" && pattern != "fifo" && pattern != "lifo" && pattern != "locality" &&
+        pattern != "message") {
+        std::cerr << "unknown pattern '" << pattern << "' (expected churn, fifo, lifo, locality, message or all)\n";
+        return 1;
+    }
+
+    std::vector<std::string> allocators;
+    try {
+        allocators = allocatorList(options, policy);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "🚀 Comparing Heap vs Memory Pool Allocation (pool on " << pagePolicyName(policy) << ")...\n\n";
+    if (pattern == "all") {
+        heapAllocationBenchmark();
+        poolAllocationBenchmark(policy);
+        for (const char* p : {"churn", "fifo", "lifo"}) interleavedBenchmark(p, allocators, policy);
+        localityBenchmark(allocators, policy);
+        messageBenchmark(allocators, policy);
+        doubleFreeCheck();
+    } else if (pattern == "locality") {
+        localityBenchmark(allocators, policy);
+    } else if (pattern == "message") {
+        messageBenchmark(allocators, policy);
+    } else {
+        interleavedBenchmark(pattern, allocators, policy);
+    }
     return 0;
 }
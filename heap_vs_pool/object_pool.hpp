@@ -0,0 +1,151 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – ObjectPool<T>
+// ---------------------------------------------------------
+
+/*
+   A fixed-size object pool: every slot holds exactly one T, and a freed
+   slot goes back on a free list to be handed out again.
+
+   - Intrusive free list: a free slot stores the pointer to the next free
+     slot in its own bytes, so the list costs no extra memory.
+   - allocate() / deallocate() are O(1): pop / push the list head, or bump
+     through the newest chunk while it still has never-used slots.
+   - Chunked growth: when both run out, one more chunk of `chunkSize`
+     slots is mapped (page policy as everywhere else). Existing objects
+     never move, and chunks are only returned in the destructor.
+   - Debug mode (ObjectPool<T, true>): every slot has a live flag, and
+     deallocate() throws std::logic_error on a double free or on a pointer
+     that this pool never handed out. It adds a chunk search per free, so
+     it is for tests, not for the hot path.
+   - prefault(lock) maps the first chunk if needed and faults in (and
+     optionally mlocks) every chunk mapped so far, so a pool sized with
+     one big chunk takes all its page faults at startup.
+
+   The destructor releases the memory but does NOT run ~T() for objects
+   still alive – destroy() them first, like with any allocator.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+template<typename T, bool DebugChecks = false>
+class ObjectPool {
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct Chunk {
+        Slot* slots;
+        std::vector<uint8_t> live; // debug mode only
+    };
+
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    static constexpr size_t SLOT_SIZE = sizeof(Slot);
+
+    explicit ObjectPool(size_t chunkSize = DEFAULT_CHUNK_SIZE, PagePolicy policy = PagePolicy::Small4K)
+        : chunkSize_(chunkSize == 0 ? 1 : chunkSize), policy_(policy) {}
+
+    ~ObjectPool() {
+        for (Chunk& chunk : chunks_) freePages(chunk.slots, chunkSize_ * sizeof(Slot), policy_);
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Raw slot of sizeof(T) bytes, suitably aligned for T.
+    void* allocate() {
+        Slot* slot;
+        if (freeList_ != nullptr) {
+            slot = freeList_;
+            freeList_ = slot->next;
+        } else {
+            if (bump_ == bumpEnd_) grow();
+            slot = bump_++;
+        }
+        if constexpr (DebugChecks) markLive(slot, true);
+        ++inUse_;
+        return slot;
+    }
+
+    void deallocate(void* p) {
+        if (p == nullptr) return;
+        Slot* slot = static_cast<Slot*>(p);
+        if constexpr (DebugChecks) markLive(slot, false);
+        slot->next = freeList_;
+        freeList_ = slot;
+        --inUse_;
+    }
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        void* p = allocate();
+        try {
+            return new (p) T{std::forward<Args>(args)...};
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    void destroy(T* object) {
+        if (object == nullptr) return;
+        object->~T();
+        deallocate(object);
+    }
+
+    // Returns false if mlock was refused; the chunks are faulted in either way.
+    bool prefault(bool lock = false) {
+        if (chunks_.empty()) grow();
+        bool locked = true;
+        for (Chunk& chunk : chunks_) locked &= prefaultPages(chunk.slots, chunkSize_ * sizeof(Slot), policy_, lock);
+        return locked;
+    }
+
+    size_t inUse() const { return inUse_; }
+    size_t capacity() const { return chunks_.size() * chunkSize_; }
+    size_t chunkCount() const { return chunks_.size(); }
+    size_t chunkSize() const { return chunkSize_; }
+
+private:
+    void grow() {
+        void* memory = allocatePages(chunkSize_ * sizeof(Slot), policy_);
+        if (memory == nullptr) throw std::bad_alloc();
+
+        Chunk chunk{static_cast<Slot*>(memory), {}};
+        if constexpr (DebugChecks) chunk.live.assign(chunkSize_, 0);
+        chunks_.push_back(std::move(chunk));
+        bump_ = chunks_.back().slots;
+        bumpEnd_ = bump_ + chunkSize_;
+    }
+
+    void markLive(Slot* slot, bool live) {
+        for (Chunk& chunk : chunks_) {
+            if (slot < chunk.slots || slot >= chunk.slots + chunkSize_) continue;
+            auto offset = reinterpret_cast<uintptr_t>(slot) - reinterpret_cast<uintptr_t>(chunk.slots);
+            if (offset % sizeof(Slot) != 0) break;
+            uint8_t& flag = chunk.live[slot - chunk.slots];
+            if (!live && flag == 0) throw std::logic_error("ObjectPool: double free or never-allocated slot");
+            flag = live ? 1 : 0;
+            return;
+        }
+        throw std::logic_error("ObjectPool: pointer does not belong to this pool");
+    }
+
+    size_t chunkSize_;
+    PagePolicy policy_;
+    std::vector<Chunk> chunks_;
+    Slot* freeList_ = nullptr;
+    Slot* bump_ = nullptr;
+    Slot* bumpEnd_ = nullptr;
+    size_t inUse_ = 0;
+};
@@ -0,0 +1,98 @@
+#include "pmr_benchmark.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pool_resource.hpp"
+#include "trade.hpp"
+
+constexpr size_t VECTOR_LENGTH = 16;
+constexpr size_t MAP_LIVE = 10'000;
+constexpr size_t LIST_LIVE = 1'000;
+
+long long vectorWorkload(std::pmr::memory_resource* resource, size_t ops) {
+    long long checksum = 0;
+    for (size_t made = 0; made < ops;) {
+        std::pmr::vector<Trade> trades(resource);
+        for (size_t i = 0; i < VECTOR_LENGTH && made < ops; ++i, ++made) {
+            trades.push_back({static_cast<int>(made), 100.5 + made, 10});
+        }
+        checksum += trades.back().id;
+    }
+    return checksum;
+}
+
+long long mapWorkload(std::pmr::memory_resource* resource, size_t ops) {
+    std::pmr::unordered_map<int, Trade> book(resource);
+    for (size_t i = 0; i < MAP_LIVE; ++i) book.emplace(static_cast<int>(i), Trade{static_cast<int>(i), 100.5, 10});
+
+    long long checksum = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        int oldest = static_cast<int>(i);
+        int newest = static_cast<int>(i + MAP_LIVE);
+        checksum += book.at(oldest).quantity;
+        book.erase(oldest);
+        book.emplace(newest, Trade{newest, 100.5 + i, 10});
+    }
+    return checksum;
+}
+
+long long listWorkload(std::pmr::memory_resource* resource, size_t ops) {
+    std::pmr::list<Trade> queue(resource);
+    for (size_t i = 0; i < LIST_LIVE; ++i) queue.push_back({static_cast<int>(i), 100.5, 10});
+
+    long long checksum = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        checksum += queue.front().quantity;
+        queue.pop_front();
+        queue.push_back({static_cast<int>(i), 100.5 + i, 10});
+    }
+    return checksum;
+}
+
+using Workload = std::function<long long(std::pmr::memory_resource*, size_t)>;
+
+void timeWorkload(const std::string& label, size_t ops, std::pmr::memory_resource* resource,
+                  const Workload& workload) {
+    auto start = std::chrono::high_resolution_clock::now();
+    long long checksum = workload(resource, ops);
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "   " << label << " took: " << static_cast<long long>(ms) << " ms, " << ms * 1e6 / ops
+              << " ns/op, checksum: " << checksum << "\n";
+}
+
+void runPmrBenchmark(size_t ops, PagePolicy policy) {
+    std::cout << "\n📦 std::pmr containers, " << ops << " ops each (PoolResource on " << pagePolicyName(policy)
+              << "):\n";
+
+    const std::pair<const char*, Workload> workloads[] = {
+        {"vector<Trade>, 16 push_backs per vector", vectorWorkload},
+        {"unordered_map<int, Trade>, erase oldest + insert", mapWorkload},
+        {"list<Trade>, pop_front + push_back", listWorkload},
+    };
+    for (const auto& [title, workload] : workloads) {
+        std::cout << "\n   " << title << ":\n";
+        timeWorkload("❌ new_delete", ops, std::pmr::new_delete_resource(), workload);
+        {
+            std::pmr::monotonic_buffer_resource monotonic;
+            timeWorkload("   monotonic", ops, &monotonic, workload);
+        }
+        {
+            std::pmr::unsynchronized_pool_resource standardPool;
+            timeWorkload("   unsynchronized_pool", ops, &standardPool, workload);
+        }
+        {
+            PoolResource pool(policy);
+            timeWorkload("✅ PoolResource", ops, &pool, workload);
+        }
+    }
+}
@@ -0,0 +1,30 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – std::pmr CONTAINERS
+// ---------------------------------------------------------
+
+/*
+   The same three container workloads on four memory resources
+   (./heap_vs_pool --mode=pmr [--ops=N]):
+
+   - vector        : a fresh std::pmr::vector<Trade> per message, grown by
+                     push_back to VECTOR_LENGTH – every growth step is an
+                     allocate + deallocate of a bigger block
+   - unordered_map : an order book of MAP_LIVE trades keyed by id; each op
+                     erases the oldest order and inserts a new one
+   - list          : a queue of LIST_LIVE trades; push_back + pop_front
+
+   Resources:
+   - new_delete          : the default heap (what plain std:: containers use)
+   - monotonic           : std::pmr::monotonic_buffer_resource, never frees
+                           until destroyed, so its footprint only grows
+   - unsynchronized_pool : the standard library's pool resource
+   - PoolResource        : this module's ObjectPools (pool_resource.hpp)
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+void runPmrBenchmark(size_t ops, PagePolicy policy);
@@ -0,0 +1,100 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – PoolResource (std::pmr adapter)
+// ---------------------------------------------------------
+
+/*
+   ObjectPool only hands out one size, but an STL container asks for
+   several: list and map nodes are fixed, while vectors and hash bucket
+   arrays grow. PoolResource is a std::pmr::memory_resource that keeps one
+   ObjectPool per power-of-two size class (16 … 1024 bytes) and rounds each
+   request up to its class, so any pmr container runs on the same free-list
+   pools as the rest of the module:
+
+       PoolResource pool;
+       std::pmr::unordered_map<int, Trade> book(&pool);
+       std::pmr::list<Trade> queue(&pool);
+
+   - Chunks are page aligned and every class from 64 bytes up is a multiple
+     of a cache line, so those blocks are all 64-byte aligned. A request
+     aligned beyond 16 is served from the class of max(bytes, alignment).
+   - Requests above 1 KB or aligned beyond 64 go to the upstream resource
+     (the default heap unless given).
+   - Not thread-safe, like std::pmr::unsynchronized_pool_resource.
+   - Memory goes back to the OS only when the resource is destroyed; every
+     container using it must be gone by then.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+
+#include "huge_pages.hpp"
+#include "object_pool.hpp"
+
+class PoolResource : public std::pmr::memory_resource {
+    template<size_t N>
+    struct alignas(N < 64 ? N : 64) Block {
+        unsigned char bytes[N];
+    };
+
+    template<size_t N>
+    using Pool = ObjectPool<Block<N>>;
+
+public:
+    static constexpr size_t MAX_BLOCK = 1024;
+    static constexpr size_t MAX_ALIGN = 64;
+    static constexpr size_t CHUNK_BYTES = 1 << 20;
+
+    explicit PoolResource(PagePolicy policy = PagePolicy::Small4K,
+                          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : pool16_(CHUNK_BYTES / 16, policy), pool32_(CHUNK_BYTES / 32, policy), pool64_(CHUNK_BYTES / 64, policy),
+          pool128_(CHUNK_BYTES / 128, policy), pool256_(CHUNK_BYTES / 256, policy),
+          pool512_(CHUNK_BYTES / 512, policy), pool1024_(CHUNK_BYTES / 1024, policy), upstream_(upstream) {}
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    // Objects currently handed out by the pools (upstream requests not counted).
+    size_t inUse() const {
+        return pool16_.inUse() + pool32_.inUse() + pool64_.inUse() + pool128_.inUse() + pool256_.inUse() +
+               pool512_.inUse() + pool1024_.inUse();
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        size_t size = std::max(bytes, alignment);
+        if (size > MAX_BLOCK || alignment > MAX_ALIGN) return upstream_->allocate(bytes, alignment);
+        if (size <= 16) return pool16_.allocate();
+        if (size <= 32) return pool32_.allocate();
+        if (size <= 64) return pool64_.allocate();
+        if (size <= 128) return pool128_.allocate();
+        if (size <= 256) return pool256_.allocate();
+        if (size <= 512) return pool512_.allocate();
+        return pool1024_.allocate();
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        size_t size = std::max(bytes, alignment);
+        if (size > MAX_BLOCK || alignment > MAX_ALIGN) return upstream_->deallocate(p, bytes, alignment);
+        if (size <= 16) return pool16_.deallocate(p);
+        if (size <= 32) return pool32_.deallocate(p);
+        if (size <= 64) return pool64_.deallocate(p);
+        if (size <= 128) return pool128_.deallocate(p);
+        if (size <= 256) return pool256_.deallocate(p);
+        if (size <= 512) return pool512_.deallocate(p);
+        pool1024_.deallocate(p);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    Pool<16> pool16_;
+    Pool<32> pool32_;
+    Pool<64> pool64_;
+    Pool<128> pool128_;
+    Pool<256> pool256_;
+    Pool<512> pool512_;
+    Pool<1024> pool1024_;
+    std::pmr::memory_resource* upstream_;
+};
@@ -0,0 +1,214 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – SlabAllocator (size classes for messages)
+// ---------------------------------------------------------
+
+/*
+   ObjectPool needs one fixed size; messages range from 32 to ~1500
+   bytes. SlabAllocator rounds each request up to a size class and gives
+   every class its own slabs:
+
+   - Size classes, picked at construction:
+       PowerOfTwo : 32, 64, 128 … up to max – few classes, up to 50 % waste
+       Fine       : 16-byte steps to 128, then 4 per doubling, the last
+                    class being max rounded up to 16 – up to 25 % waste
+   - Slab = SLAB_BYTES, aligned to SLAB_BYTES. Its header (class, free
+     count, free bitmap) sits in the first cache lines and the objects
+     start on the next cache-line boundary, so deallocate() finds the
+     header by masking the pointer. The caller passes the size back, as
+     with sized delete, only so deallocate() can tell slab objects from
+     large requests.
+   - Only the first object in a slab is line aligned for every class.
+     Later ones are too only when the class is a multiple of 64
+     (PowerOfTwo from 64 up), not for Fine classes like 48, 80 or 160.
+   - Tracking is a bitmap (1 = free): allocate() takes the lowest set bit
+     of the first non-empty word (std::countr_zero), starting from a hint.
+     Freed objects are reused lowest-address first, which keeps the hot
+     part of each slab small.
+   - Each class keeps a list of slabs with free objects. Slabs are carved
+     from SPAN_BYTES spans mapped with the page policy (over-mapped by one
+     slab so every slab can be aligned); nothing is returned to the OS
+     before the destructor. Requests above the largest class go to malloc.
+   - Not thread-safe; use one per thread, like ObjectPool.
+
+   usableSize(p, bytes) is the class size, for measuring internal
+   fragmentation.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+class SlabAllocator {
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t MIN_OBJECT = 32;
+
+public:
+    static constexpr size_t SLAB_BYTES = 64 * 1024;
+    static constexpr size_t SPAN_BYTES = 2 * 1024 * 1024;
+    static constexpr size_t MAX_CLASS_LIMIT = 8192;
+
+    enum class Spacing {
+        PowerOfTwo,
+        Fine,
+    };
+
+    explicit SlabAllocator(Spacing spacing, size_t maxSize = 2048, PagePolicy policy = PagePolicy::Small4K)
+        : policy_(policy) {
+        if (maxSize < MIN_OBJECT || maxSize > MAX_CLASS_LIMIT) {
+            throw std::invalid_argument("slab classes must top out between 32 and 8192 bytes");
+        }
+        if (spacing == Spacing::PowerOfTwo) {
+            for (size_t size = MIN_OBJECT; sizes_.empty() || sizes_.back() < maxSize; size *= 2) {
+                sizes_.push_back(size);
+            }
+        } else {
+            maxSize = (maxSize + 15) / 16 * 16;
+            for (size_t size = MIN_OBJECT; size <= 128 && size < maxSize; size += 16) sizes_.push_back(size);
+            for (size_t base = 128; base < maxSize; base *= 2) {
+                for (size_t step = 1; step <= 4 && base + base / 4 * step < maxSize; ++step) {
+                    sizes_.push_back(base + base / 4 * step);
+                }
+            }
+            sizes_.push_back(maxSize);
+        }
+
+        lookup_.resize(sizes_.back() / 16 + 1);
+        for (size_t granule = 0, cls = 0; granule < lookup_.size(); ++granule) {
+            while (sizes_[cls] < granule * 16) ++cls;
+            lookup_[granule] = static_cast<uint16_t>(cls);
+        }
+        partial_.assign(sizes_.size(), nullptr);
+    }
+
+    ~SlabAllocator() {
+        for (Span& span : spans_) freePages(span.begin, SPAN_BYTES + SLAB_BYTES, policy_);
+    }
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    void* allocate(size_t bytes) {
+        if (bytes > sizes_.back()) {
+            void* p = std::malloc(bytes);
+            if (p == nullptr) throw std::bad_alloc();
+            return p;
+        }
+        size_t cls = lookup_[(bytes + 15) / 16];
+        Slab* slab = partial_[cls];
+        if (slab == nullptr) slab = newSlab(cls);
+
+        size_t word = slab->hint;
+        while (slab->freeBits[word] == 0) ++word;
+        size_t bit = std::countr_zero(slab->freeBits[word]);
+        slab->freeBits[word] &= slab->freeBits[word] - 1;
+        slab->hint = static_cast<uint16_t>(word);
+        if (--slab->freeCount == 0) unlink(slab);
+        return objectsOf(slab) + (word * 64 + bit) * slab->objectSize;
+    }
+
+    // `bytes` is the size passed to allocate().
+    void deallocate(void* p, size_t bytes) {
+        if (p == nullptr) return;
+        if (bytes > sizes_.back()) return std::free(p);
+        Slab* slab = slabOf(p);
+
+        size_t index = (static_cast<unsigned char*>(p) - objectsOf(slab)) / slab->objectSize;
+        size_t word = index / 64;
+        slab->freeBits[word] |= uint64_t{1} << (index % 64);
+        slab->hint = static_cast<uint16_t>(std::min<size_t>(slab->hint, word));
+        if (slab->freeCount++ == 0) pushPartial(slab);
+    }
+
+    size_t usableSize(const void* p, size_t bytes) const {
+        return bytes > sizes_.back() ? bytes : slabOf(p)->objectSize;
+    }
+
+    const std::vector<size_t>& classSizes() const { return sizes_; }
+    size_t slabCount() const { return slabs_; }
+    size_t bytesMapped() const { return spans_.size() * (SPAN_BYTES + SLAB_BYTES); }
+
+private:
+    static constexpr size_t MAX_OBJECTS = SLAB_BYTES / MIN_OBJECT;
+
+    struct Slab {
+        uint32_t objectSize;
+        uint32_t objectCount;
+        uint32_t freeCount;
+        uint16_t sizeClass;
+        uint16_t hint; // no free object in the words before this one
+        Slab* prev;
+        Slab* next;
+        uint64_t freeBits[MAX_OBJECTS / 64];
+    };
+
+    static constexpr size_t HEADER_BYTES = (sizeof(Slab) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+    struct Span {
+        unsigned char* begin; // as mapped
+        unsigned char* next;  // next free slab, SLAB_BYTES-aligned
+        unsigned char* end;
+    };
+
+    static unsigned char* objectsOf(Slab* slab) { return reinterpret_cast<unsigned char*>(slab) + HEADER_BYTES; }
+
+    static Slab* slabOf(const void* p) {
+        return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t{SLAB_BYTES} - 1));
+    }
+
+    Slab* newSlab(size_t cls) {
+        if (spans_.empty() || spans_.back().next == spans_.back().end) mapSpan();
+        Span& span = spans_.back();
+        Slab* slab = reinterpret_cast<Slab*>(span.next);
+        span.next += SLAB_BYTES;
+        ++slabs_;
+
+        slab->objectSize = static_cast<uint32_t>(sizes_[cls]);
+        slab->objectCount = static_cast<uint32_t>((SLAB_BYTES - HEADER_BYTES) / sizes_[cls]);
+        slab->freeCount = slab->objectCount;
+        slab->sizeClass = static_cast<uint16_t>(cls);
+        slab->hint = 0;
+        std::fill(std::begin(slab->freeBits), std::end(slab->freeBits), 0);
+        for (size_t i = 0; i < slab->objectCount; ++i) slab->freeBits[i / 64] |= uint64_t{1} << (i % 64);
+        pushPartial(slab);
+        return slab;
+    }
+
+    void mapSpan() {
+        void* memory = allocatePages(SPAN_BYTES + SLAB_BYTES, policy_);
+        if (memory == nullptr) throw std::bad_alloc();
+        auto begin = static_cast<unsigned char*>(memory);
+        auto address = reinterpret_cast<uintptr_t>(begin);
+        unsigned char* first = begin + ((SLAB_BYTES - address % SLAB_BYTES) % SLAB_BYTES);
+        spans_.push_back({begin, first, first + SPAN_BYTES});
+    }
+
+    void pushPartial(Slab* slab) {
+        Slab*& head = partial_[slab->sizeClass];
+        slab->prev = nullptr;
+        slab->next = head;
+        if (head != nullptr) head->prev = slab;
+        head = slab;
+    }
+
+    void unlink(Slab* slab) {
+        if (slab->prev != nullptr) slab->prev->next = slab->next;
+        else partial_[slab->sizeClass] = slab->next;
+        if (slab->next != nullptr) slab->next->prev = slab->prev;
+    }
+
+    PagePolicy policy_;
+    std::vector<size_t> sizes_;
+    std::vector<uint16_t> lookup_;
+    std::vector<Slab*> partial_;
+    std::vector<Span> spans_;
+    size_t slabs_ = 0;
+};
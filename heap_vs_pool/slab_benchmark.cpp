@@ -0,0 +1,165 @@
+#include "slab_benchmark.hpp"
+
+#include <malloc.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "slab_allocator.hpp"
+
+constexpr size_t LIVE_MESSAGES = 100'000;
+constexpr size_t TOUCH_BYTES = 64;
+
+struct SizeBucket {
+    size_t upper;
+    double weight;
+};
+
+std::vector<SizeBucket> parseHistogram(const std::string& text) {
+    std::vector<SizeBucket> buckets;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        size_t colon = item.find(':');
+        SizeBucket bucket{};
+        try {
+            if (colon == std::string::npos) throw std::invalid_argument(item);
+            bucket = {std::stoul(item.substr(0, colon)), std::stod(item.substr(colon + 1))};
+        } catch (const std::exception&) {
+            throw std::invalid_argument("bad size bucket '" + item + "' (expected upper:weight)");
+        }
+        if (bucket.upper == 0 || bucket.weight < 0 || (!buckets.empty() && bucket.upper <= buckets.back().upper)) {
+            throw std::invalid_argument("size buckets need increasing, non-zero bounds and weights >= 0");
+        }
+        buckets.push_back(bucket);
+    }
+    if (buckets.empty()) throw std::invalid_argument("empty size histogram");
+    double total = 0;
+    for (const SizeBucket& b : buckets) total += b.weight;
+    if (total <= 0) throw std::invalid_argument("size histogram weights sum to zero");
+    return buckets;
+}
+
+// Message sizes drawn from the histogram, precomputed so no allocator pays for the draw.
+std::vector<uint32_t> drawSizes(const std::vector<SizeBucket>& buckets, size_t count) {
+    std::vector<double> weights;
+    for (const SizeBucket& b : buckets) weights.push_back(b.weight);
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    std::mt19937_64 rng(42);
+
+    std::vector<uint32_t> sizes(count);
+    for (uint32_t& size : sizes) {
+        size_t b = pick(rng);
+        size_t lower = b == 0 ? 0 : buckets[b - 1].upper;
+        size = static_cast<uint32_t>(lower + 1 + rng() % (buckets[b].upper - lower));
+    }
+    return sizes;
+}
+
+struct MallocMessages {
+    const char* name() const { return "malloc"; }
+    void* get(size_t bytes) {
+        void* p = std::malloc(bytes);
+        if (p == nullptr) throw std::bad_alloc();
+        return p;
+    }
+    void put(void* p, size_t) { std::free(p); }
+    size_t usable(void* p, size_t) const { return malloc_usable_size(p); }
+};
+
+struct SlabMessages {
+    SlabAllocator slabs;
+    std::string label;
+
+    SlabMessages(SlabAllocator::Spacing spacing, size_t maxSize, PagePolicy policy)
+        : slabs(spacing, maxSize, policy) {
+        label = std::string("slab ") + (spacing == SlabAllocator::Spacing::Fine ? "fine" : "pow2") + " (" +
+                std::to_string(slabs.classSizes().size()) + " classes)";
+    }
+    const char* name() const { return label.c_str(); }
+    void* get(size_t bytes) { return slabs.allocate(bytes); }
+    void put(void* p, size_t bytes) { slabs.deallocate(p, bytes); }
+    size_t usable(void* p, size_t bytes) const { return slabs.usableSize(p, bytes); }
+};
+
+struct Message {
+    void* p;
+    uint32_t size;
+};
+
+// Fills the live set, then frees a random message and allocates the next size `ops` times.
+template<typename Allocator>
+void churnMessages(Allocator& alloc, const std::vector<uint32_t>& sizes, size_t ops) {
+    std::vector<Message> live(LIVE_MESSAGES);
+    std::mt19937_64 victims(7);
+    size_t next = 0;
+    auto make = [&] {
+        uint32_t size = sizes[next++ % sizes.size()];
+        void* p = alloc.get(size);
+        std::memset(p, 0x5a, std::min<size_t>(size, TOUCH_BYTES));
+        return Message{p, size};
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (Message& m : live) m = make();
+    for (size_t i = 0; i < ops; ++i) {
+        Message& victim = live[victims() % LIVE_MESSAGES];
+        alloc.put(victim.p, victim.size);
+        victim = make();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    size_t requested = 0, reserved = 0;
+    for (const Message& m : live) {
+        requested += m.size;
+        reserved += alloc.usable(m.p, m.size);
+    }
+    for (const Message& m : live) alloc.put(m.p, m.size);
+
+    std::cout << " " << std::left << std::setw(24) << alloc.name() << std::right << " took: " << std::setw(5)
+              << static_cast<long long>(ms) << " ms, " << std::fixed << std::setprecision(1) << std::setw(6)
+              << ms * 1e6 / (ops + LIVE_MESSAGES) << " ns/alloc+free, internal waste: " << std::setw(5)
+              << 100.0 * (reserved - requested) / reserved << "% (" << (reserved - requested) / 1024 << " KB of "
+              << reserved / 1024 << " KB)";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+void runSlabBenchmark(const std::string& histogram, const std::string& classes, size_t ops, PagePolicy policy) {
+    if (classes != "pow2" && classes != "fine" && classes != "all") {
+        throw std::invalid_argument("unknown size classes '" + classes + "' (expected pow2, fine or all)");
+    }
+    std::vector<SizeBucket> buckets = parseHistogram(histogram);
+    size_t maxSize = buckets.back().upper;
+    if (maxSize > SlabAllocator::MAX_CLASS_LIMIT) {
+        throw std::invalid_argument("largest message must be at most " +
+                                    std::to_string(SlabAllocator::MAX_CLASS_LIMIT) + " bytes");
+    }
+    std::vector<uint32_t> sizes = drawSizes(buckets, LIVE_MESSAGES + ops);
+
+    std::cout << "\n📨 Variable-size messages (" << histogram << "), " << LIVE_MESSAGES << " live, " << ops
+              << " replacements:\n";
+    {
+        MallocMessages heap;
+        std::cout << "❌";
+        churnMessages(heap, sizes, ops);
+        std::cout << "\n";
+    }
+    for (auto spacing : {SlabAllocator::Spacing::PowerOfTwo, SlabAllocator::Spacing::Fine}) {
+        bool fine = spacing == SlabAllocator::Spacing::Fine;
+        if (classes != "all" && (classes == "fine") != fine) continue;
+        SlabMessages slab(spacing, std::max<size_t>(maxSize, 32), policy);
+        std::cout << "✅";
+        churnMessages(slab, sizes, ops);
+        std::cout << ", " << slab.slabs.slabCount() << " slabs / " << slab.slabs.bytesMapped() / (1024 * 1024)
+                  << " MB mapped\n";
+    }
+}
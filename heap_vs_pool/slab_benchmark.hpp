@@ -0,0 +1,31 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – VARIABLE-SIZE MESSAGES: SLABS VS MALLOC
+// ---------------------------------------------------------
+
+/*
+   Churns a live set of messages whose sizes follow a histogram, on
+   malloc and on SlabAllocator with power-of-two and with fine size
+   classes (slab_allocator.hpp). Every backend sees the same sizes.
+
+   The histogram is a list of upper-bound:weight buckets; a size is drawn
+   uniformly between the previous bound (exclusive) and the bucket's own:
+
+       ./heap_vs_pool --mode=slab [--sizes=64:40,128:25,256:15,512:10,1500:10]
+                      [--ops=N] [--classes=pow2|fine|all]
+
+   Besides speed it reports internal fragmentation over the final live
+   set: bytes the allocator actually reserved per object (class size, or
+   malloc_usable_size() for malloc) against bytes requested.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "huge_pages.hpp"
+
+constexpr const char* DEFAULT_SIZE_HISTOGRAM = "64:40,128:25,256:15,512:10,1500:10";
+
+// Throws std::invalid_argument for a malformed histogram or class spacing.
+void runSlabBenchmark(const std::string& histogram, const std::string& classes, size_t ops, PagePolicy policy);
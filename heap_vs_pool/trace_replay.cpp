@@ -0,0 +1,142 @@
+#include "trace_replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+constexpr size_t TOUCH_BYTES = 64;
+
+double percentile(const std::vector<uint32_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+ReplayResult replayTrace(const AllocationTrace& trace, AllocatorBackend& backend) {
+    // Split the events per thread once, outside the timed region.
+    std::vector<std::vector<const TraceEvent*>> perThread(trace.threads);
+    for (const TraceEvent& e : trace.events) perThread[e.thread].push_back(&e);
+
+    std::vector<uint32_t> sizes(trace.objects);
+    for (const TraceEvent& e : trace.events) {
+        if (e.kind == TraceEvent::Alloc) sizes[e.object] = e.size;
+    }
+
+    // Published pointer per object; null until its allocation has happened.
+    std::unique_ptr<std::atomic<void*>[]> objects(new std::atomic<void*>[trace.objects]);
+    for (size_t i = 0; i < trace.objects; ++i) objects[i].store(nullptr, std::memory_order_relaxed);
+
+    std::vector<std::vector<uint32_t>> latencies(trace.threads);
+    for (size_t t = 0; t < trace.threads; ++t) latencies[t].reserve(perThread[t].size() / LATENCY_SAMPLE_EVERY + 1);
+
+    long long rssBefore = residentBytes();
+    backend.prepare(trace.threads, traceStats(trace).allocations);
+    StaticThreadPool threads(trace.threads);
+
+    // An exception escaping a pool worker would terminate the process, so a
+    // backend running out of memory stops every thread and fails the replay.
+    std::atomic<bool> outOfMemory{false};
+
+    auto replayThread = [&](size_t t) {
+        for (size_t i = 0; i < perThread[t].size() && !outOfMemory.load(std::memory_order_relaxed); ++i) {
+            const TraceEvent* e = perThread[t][i];
+            std::atomic<void*>& slot = objects[e->object];
+            bool sampled = i % LATENCY_SAMPLE_EVERY == 0;
+            std::chrono::high_resolution_clock::time_point begin;
+            if (e->kind == TraceEvent::Alloc) {
+                if (sampled) begin = std::chrono::high_resolution_clock::now();
+                void* p = backend.allocate(e->size, t);
+                std::memset(p, static_cast<int>(e->object), std::min<size_t>(e->size, TOUCH_BYTES));
+                if (sampled) {
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::high_resolution_clock::now() - begin);
+                    latencies[t].push_back(static_cast<uint32_t>(ns.count()));
+                }
+                slot.store(p, std::memory_order_release);
+            } else {
+                void* p;
+                while ((p = slot.load(std::memory_order_acquire)) == nullptr) {
+                    if (outOfMemory.load(std::memory_order_relaxed)) return;
+                    std::this_thread::yield();
+                }
+                if (sampled) begin = std::chrono::high_resolution_clock::now();
+                backend.deallocate(p, sizes[e->object], t);
+                if (sampled) {
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::high_resolution_clock::now() - begin);
+                    latencies[t].push_back(static_cast<uint32_t>(ns.count()));
+                }
+            }
+        }
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    threads.run([&](size_t t) {
+        try {
+            replayThread(t);
+        } catch (const std::bad_alloc&) {
+            outOfMemory.store(true, std::memory_order_relaxed);
+            return;
+        }
+        backend.threadDone(t);
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+
+    ReplayResult result;
+    // Whatever was live stays allocated; the backend's own pages go with it.
+    if (outOfMemory.load()) {
+        result.outOfMemory = true;
+        return result;
+    }
+    result.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.opsPerSec = trace.events.size() / (result.ms / 1000);
+    result.rssGrowthBytes = residentBytes() - rssBefore;
+
+    std::vector<uint32_t> all;
+    for (const auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+    std::sort(all.begin(), all.end());
+    result.p50Ns = percentile(all, 0.50);
+    result.p99Ns = percentile(all, 0.99);
+    result.p999Ns = percentile(all, 0.999);
+    result.maxNs = all.empty() ? 0 : all.back();
+    return result;
+}
+
+void runTraceReplay(const AllocationTrace& trace, const std::vector<std::string>& allocators, PagePolicy policy) {
+    TraceStats stats = traceStats(trace);
+    std::cout << "\n🎞️ Replaying " << trace.events.size() << " events on " << trace.threads << " threads: "
+              << stats.allocations << " allocations, " << stats.crossThreadFrees << " cross-thread frees, peak "
+              << stats.peakLiveObjects << " live objects / " << stats.peakLiveBytes / 1024 << " KB\n";
+    if (const char* preload = std::getenv("LD_PRELOAD")) {
+        std::cout << "   (LD_PRELOAD=" << preload << ": 'malloc' is the preloaded allocator, not glibc)\n";
+    }
+
+    std::cout << "   " << std::left << std::setw(24) << "allocator" << std::right << std::setw(10) << "ms"
+              << std::setw(10) << "M ev/s" << std::setw(9) << "p50 ns" << std::setw(9) << "p99 ns"
+              << std::setw(10) << "p99.9 ns" << std::setw(10) << "max ns" << std::setw(12) << "RSS +MB" << "\n";
+    for (const std::string& name : allocators) {
+        std::unique_ptr<AllocatorBackend> backend = makeBackend(name, policy);
+        ReplayResult r = replayTrace(trace, *backend);
+        if (r.outOfMemory) {
+            std::cout << "   " << std::left << std::setw(24) << backend->name() << std::right
+                      << "   out of memory, replay abandoned\n";
+            continue;
+        }
+        std::cout << "   " << std::left << std::setw(24) << backend->name() << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(10) << r.ms << std::setprecision(2) << std::setw(10)
+                  << r.opsPerSec / 1e6 << std::setprecision(0) << std::setw(9) << r.p50Ns << std::setw(9)
+                  << r.p99Ns << std::setw(10) << r.p999Ns << std::setw(10) << r.maxNs << std::setprecision(1)
+                  << std::setw(12) << r.rssGrowthBytes / (1024.0 * 1024.0) << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+}
@@ -0,0 +1,52 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – TRACE REPLAY
+// ---------------------------------------------------------
+
+/*
+   Replays an AllocationTrace against an AllocatorBackend on one real
+   thread per trace thread. Each thread runs its own events in trace
+   order; a free of an object allocated on another thread spins (yielding)
+   until that allocation has been published, so cross-thread frees happen
+   in the same order as in the trace. Every allocation's first cache line
+   is written, as a real object's constructor would.
+
+   Besides throughput, every LATENCY_SAMPLE_EVERY-th event of each thread
+   is timed on its own (the allocate/deallocate call only, not the wait
+   for a cross-thread pointer), and resident memory is read from
+   /proc/self/statm before prepare() and after the last event, while the
+   backend still holds whatever it has cached.
+
+   If a backend throws std::bad_alloc the replay stops on every thread and
+   that backend's row says so; the remaining backends still run.
+
+   ./heap_vs_pool --mode=trace [--trace=FILE | --trace-gen=churn|pc|mixed]
+                  [--events=N] [--threads=N] [--save-trace=FILE]
+                  [--allocator=NAME[,NAME...]|all] [--allocator-lib=PATH]
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "allocation_trace.hpp"
+#include "allocator_backend.hpp"
+
+constexpr size_t LATENCY_SAMPLE_EVERY = 8;
+
+struct ReplayResult {
+    double ms = 0;
+    double opsPerSec = 0; // allocations + frees per second
+    // Sampled per-event latency.
+    double p50Ns = 0;
+    double p99Ns = 0;
+    double p999Ns = 0;
+    double maxNs = 0;
+    long long rssGrowthBytes = 0; // resident set after replay minus before prepare()
+    bool outOfMemory = false;     // the backend threw std::bad_alloc; nothing else is set
+};
+
+ReplayResult replayTrace(const AllocationTrace& trace, AllocatorBackend& backend);
+
+// Replays `trace` on each named backend and prints the results side by side.
+void runTraceReplay(const AllocationTrace& trace, const std::vector<std::string>& allocators, PagePolicy policy);
@@ -0,0 +1,16 @@
+// ---------------------------------------------------------
+// HEAP VS POOL – THE OBJECT BEING ALLOCATED
+// ---------------------------------------------------------
+
+/*
+   The record every heap_vs_pool benchmark allocates: 24 bytes with padding,
+   a typical small, short-lived message object.
+*/
+
+#pragma once
+
+struct Trade {
+    int id;
+    double price;
+    int quantity;
+};
@@ -0,0 +1,328 @@
+#include "compressed_column.hpp"
+
+#include <immintrin.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "simd_reductions.hpp"
+
+static uint32_t maskFor(unsigned bits) {
+    return bits >= 32 ? ~0u : (1u << bits) - 1;
+}
+
+static unsigned bitWidth(uint32_t v) {
+    return v == 0 ? 0 : 32 - __builtin_clz(v);
+}
+
+static uint32_t zigzagEncode(int32_t d) {
+    return (static_cast<uint32_t>(d) << 1) ^ static_cast<uint32_t>(d >> 31);
+}
+
+static int32_t zigzagDecode(uint32_t u) {
+    return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+}
+
+void packBlock(const uint32_t* in, unsigned bits, uint32_t* out) {
+    std::fill(out, out + bits * PACK_LANES, 0u);
+    for (size_t lane = 0; lane < PACK_LANES; ++lane) {
+        size_t bitPos = 0;
+        for (size_t k = 0; k < PACK_VALUES_PER_LANE; ++k, bitPos += bits) {
+            uint32_t v = in[k * PACK_LANES + lane];
+            size_t word = bitPos / 32;
+            unsigned offset = bitPos % 32;
+            out[word * PACK_LANES + lane] |= v << offset;
+            if (offset + bits > 32) out[(word + 1) * PACK_LANES + lane] |= v >> (32 - offset);
+        }
+    }
+}
+
+void unpackBlock(const uint32_t* in, unsigned bits, uint32_t* out) {
+    uint32_t mask = maskFor(bits);
+    for (size_t lane = 0; lane < PACK_LANES; ++lane) {
+        size_t bitPos = 0;
+        for (size_t k = 0; k < PACK_VALUES_PER_LANE; ++k, bitPos += bits) {
+            if (bits == 0) {
+                out[k * PACK_LANES + lane] = 0;
+                continue;
+            }
+            size_t word = bitPos / 32;
+            unsigned offset = bitPos % 32;
+            uint64_t v = in[word * PACK_LANES + lane] >> offset;
+            if (offset + bits > 32) v |= uint64_t(in[(word + 1) * PACK_LANES + lane]) << (32 - offset);
+            out[k * PACK_LANES + lane] = static_cast<uint32_t>(v) & mask;
+        }
+    }
+}
+
+// Decodes the next 8 values (one per lane) of a vertically packed block.
+// `word` / `offset` track the read position and are advanced in place.
+__attribute__((target("avx2")))
+static inline __m256i unpackStep(const uint32_t* in, unsigned bits, __m256i mask,
+                                 size_t& word, unsigned& offset, __m256i& current) {
+    __m256i v = _mm256_srl_epi32(current, _mm_cvtsi32_si128(static_cast<int>(offset)));
+    if (offset + bits > 32) {
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + (word + 1) * PACK_LANES));
+        v = _mm256_or_si256(v, _mm256_sll_epi32(next, _mm_cvtsi32_si128(static_cast<int>(32 - offset))));
+    }
+    offset += bits;
+    if (offset >= 32) {
+        offset -= 32;
+        ++word;
+        if (word < bits) current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + word * PACK_LANES));
+    }
+    return _mm256_and_si256(v, mask);
+}
+
+__attribute__((target("avx2")))
+static float horizontalSum8(__m256 v) {
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+    return _mm_cvtss_f32(lo);
+}
+
+// ---- Float16Column ----
+
+Float16Column::Float16Column(const float* values, size_t count, PagePolicy policy)
+    : count_(count), halves_(count, PageAllocator<uint16_t>(policy)) {
+    for (size_t i = 0; i < count; ++i) {
+        _Float16 h = static_cast<_Float16>(values[i]);
+        std::memcpy(&halves_[i], &h, sizeof(h));
+    }
+}
+
+float Float16Column::at(size_t i) const {
+    _Float16 h;
+    std::memcpy(&h, &halves_[i], sizeof(h));
+    return static_cast<float>(h);
+}
+
+float Float16Column::sumScalar() const {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count_; ++i) sum += at(i);
+    return sum;
+}
+
+__attribute__((target("avx2,f16c")))
+float Float16Column::sumSimd() const {
+    const uint16_t* h = halves_.data();
+    __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+    __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= count_; i += 32) {
+        a0 = _mm256_add_ps(a0, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i))));
+        a1 = _mm256_add_ps(a1, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + 8))));
+        a2 = _mm256_add_ps(a2, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + 16))));
+        a3 = _mm256_add_ps(a3, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + 24))));
+    }
+    float sum = horizontalSum8(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+    for (; i < count_; ++i) sum += at(i);
+    return sum;
+}
+
+// ---- BitPackedColumn ----
+
+BitPackedColumn::BitPackedColumn(const float* values, size_t count, unsigned bits, PagePolicy policy)
+    : count_(count), bits_(bits), words_(PageAllocator<uint32_t>(policy)) {
+    if (count == 0) return;
+    auto [lo, hi] = std::minmax_element(values, values + count);
+    min_ = *lo;
+    quantum_ = (*hi - *lo) / static_cast<float>(maskFor(bits));
+    if (quantum_ == 0.0f) quantum_ = 1.0f;
+
+    size_t blocks = count / PACK_BLOCK;
+    words_.resize(blocks * bits * PACK_LANES);
+    uint32_t quantised[PACK_BLOCK];
+    for (size_t b = 0; b < blocks; ++b) {
+        for (size_t i = 0; i < PACK_BLOCK; ++i) {
+            float q = std::round((values[b * PACK_BLOCK + i] - min_) / quantum_);
+            quantised[i] = std::min(static_cast<uint32_t>(q), maskFor(bits));
+        }
+        packBlock(quantised, bits, words_.data() + b * bits * PACK_LANES);
+    }
+    tail_.assign(values + blocks * PACK_BLOCK, values + count);
+}
+
+float BitPackedColumn::sumScalar() const {
+    float sum = 0.0f;
+    uint32_t decoded[PACK_BLOCK];
+    size_t blocks = count_ / PACK_BLOCK;
+    for (size_t b = 0; b < blocks; ++b) {
+        unpackBlock(words_.data() + b * bits_ * PACK_LANES, bits_, decoded);
+        for (size_t i = 0; i < PACK_BLOCK; ++i) sum += min_ + decoded[i] * quantum_;
+    }
+    for (float v : tail_) sum += v;
+    return sum;
+}
+
+__attribute__((target("avx2")))
+float BitPackedColumn::sumSimd() const {
+    const __m256i mask = _mm256_set1_epi32(static_cast<int>(maskFor(bits_)));
+    const __m256 minV = _mm256_set1_ps(min_);
+    const __m256 quantumV = _mm256_set1_ps(quantum_);
+    __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+
+    size_t blocks = count_ / PACK_BLOCK;
+    for (size_t b = 0; b < blocks; ++b) {
+        const uint32_t* in = words_.data() + b * bits_ * PACK_LANES;
+        size_t word = 0;
+        unsigned offset = 0;
+        __m256i current = bits_ ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) : _mm256_setzero_si256();
+
+        for (size_t k = 0; k < PACK_VALUES_PER_LANE; k += 2) {
+            __m256i q0 = unpackStep(in, bits_, mask, word, offset, current);
+            __m256i q1 = unpackStep(in, bits_, mask, word, offset, current);
+            a0 = _mm256_add_ps(a0, _mm256_add_ps(minV, _mm256_mul_ps(_mm256_cvtepi32_ps(q0), quantumV)));
+            a1 = _mm256_add_ps(a1, _mm256_add_ps(minV, _mm256_mul_ps(_mm256_cvtepi32_ps(q1), quantumV)));
+        }
+    }
+
+    float sum = horizontalSum8(_mm256_add_ps(a0, a1));
+    for (float v : tail_) sum += v;
+    return sum;
+}
+
+// ---- DeltaColumn ----
+
+DeltaColumn::DeltaColumn(const float* values, size_t count, float quantum, PagePolicy policy)
+    : count_(count), quantum_(quantum), words_(PageAllocator<uint32_t>(policy)) {
+    size_t blocks = count / PACK_BLOCK;
+    blockBits_.resize(blocks);
+
+    int32_t previous[PACK_LANES] = {};
+    uint32_t deltas[PACK_BLOCK];
+    uint32_t packed[32 * PACK_LANES];
+    for (size_t b = 0; b < blocks; ++b) {
+        uint32_t widest = 0;
+        for (size_t i = 0; i < PACK_BLOCK; ++i) {
+            auto fixed = static_cast<int32_t>(std::lround(values[b * PACK_BLOCK + i] / quantum));
+            deltas[i] = zigzagEncode(fixed - previous[i % PACK_LANES]);
+            previous[i % PACK_LANES] = fixed;
+            widest |= deltas[i];
+        }
+        unsigned bits = bitWidth(widest);
+        blockBits_[b] = static_cast<uint8_t>(bits);
+        packBlock(deltas, bits, packed);
+        words_.insert(words_.end(), packed, packed + bits * PACK_LANES);
+    }
+    tail_.assign(values + blocks * PACK_BLOCK, values + count);
+}
+
+double DeltaColumn::averageBits() const {
+    if (blockBits_.empty()) return 0.0;
+    double total = 0.0;
+    for (uint8_t b : blockBits_) total += b;
+    return total / blockBits_.size();
+}
+
+float DeltaColumn::sumScalar() const {
+    float sum = 0.0f;
+    int32_t running[PACK_LANES] = {};
+    uint32_t decoded[PACK_BLOCK];
+    const uint32_t* in = words_.data();
+
+    for (uint8_t bits : blockBits_) {
+        unpackBlock(in, bits, decoded);
+        in += bits * PACK_LANES;
+        for (size_t i = 0; i < PACK_BLOCK; ++i) {
+            running[i % PACK_LANES] += zigzagDecode(decoded[i]);
+            sum += running[i % PACK_LANES] * quantum_;
+        }
+    }
+    for (float v : tail_) sum += v;
+    return sum;
+}
+
+__attribute__((target("avx2")))
+float DeltaColumn::sumSimd() const {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 quantumV = _mm256_set1_ps(quantum_);
+    __m256i running = _mm256_setzero_si256();
+    __m256 a0 = _mm256_setzero_ps();
+    const uint32_t* in = words_.data();
+
+    for (uint8_t bits : blockBits_) {
+        const __m256i mask = _mm256_set1_epi32(static_cast<int>(maskFor(bits)));
+        size_t word = 0;
+        unsigned offset = 0;
+        __m256i current = bits ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)) : _mm256_setzero_si256();
+
+        for (size_t k = 0; k < PACK_VALUES_PER_LANE; ++k) {
+            __m256i u = unpackStep(in, bits, mask, word, offset, current);
+            // zig-zag decode: (u >> 1) ^ -(u & 1)
+            __m256i d = _mm256_xor_si256(_mm256_srli_epi32(u, 1),
+                                         _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(u, one)));
+            running = _mm256_add_epi32(running, d);
+            a0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_cvtepi32_ps(running), quantumV));
+        }
+        in += bits * PACK_LANES;
+    }
+
+    float sum = horizontalSum8(a0);
+    for (float v : tail_) sum += v;
+    return sum;
+}
+
+// ---- benchmark ----
+
+template<typename Kernel>
+void timeDecode(const std::string& label, size_t count, size_t storedBytes, double reference, Kernel kernel) {
+    auto start = std::chrono::high_resolution_clock::now();
+    float sum = kernel();
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "   " << label << " took: " << static_cast<long long>(seconds * 1000) << " ms, "
+              << double(storedBytes) / count << " B/value, " << count / seconds / 1e9 << " Gvalues/s, sum: "
+              << sum << ", rel. error: " << std::fabs(sum - reference) / std::fabs(reference) << '\n';
+}
+
+void runCompressedColumns(size_t count, PagePolicy policy) {
+    constexpr float TICK = 0.01f;
+    constexpr unsigned PACKED_BITS = 16;
+
+    std::cout << "\n🗜️ Compressed columns over " << count << " tick prices\n";
+
+    // Tick-like column: a random walk of ±1 tick around 100.00.
+    PageArray<float> x(count, policy);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> step(-1, 1);
+    int32_t ticks = 10'000;
+    for (size_t i = 0; i < count; ++i) {
+        ticks += step(rng);
+        x[i] = ticks * TICK;
+    }
+
+    // Exact (double) reference. A single float accumulator drifts badly at ~1e9,
+    // so compare codecs on the SIMD rows: there the error is mostly encoding.
+    double reference = 0.0;
+    for (size_t i = 0; i < count; ++i) reference += x[i];
+
+    Float16Column half(x.data(), count, policy);
+    BitPackedColumn packed(x.data(), count, PACKED_BITS, policy);
+    DeltaColumn delta(x.data(), count, TICK, policy);
+    std::cout << "   delta column averages " << delta.averageBits() << " bits/value\n";
+
+    bool avx2 = detectSimdLevel() >= SimdLevel::Avx2;
+    bool f16c = avx2 && __builtin_cpu_supports("f16c");
+    ColumnSumFn simdSum = selectColumnSum(detectSimdLevel());
+    size_t rawBytes = count * sizeof(float);
+
+    timeDecode("raw float strict", count, rawBytes, reference, [&] { return sumColumnStrict(x.data(), count); });
+    timeDecode("raw float SIMD", count, rawBytes, reference, [&] { return simdSum(x.data(), count); });
+
+    timeDecode("float16 scalar", count, half.bytes(), reference, [&] { return half.sumScalar(); });
+    if (f16c) timeDecode("float16 F16C", count, half.bytes(), reference, [&] { return half.sumSimd(); });
+
+    std::string packedName = "bit-packed " + std::to_string(PACKED_BITS) + "b";
+    timeDecode(packedName + " scalar", count, packed.bytes(), reference, [&] { return packed.sumScalar(); });
+    if (avx2) timeDecode(packedName + " AVX2", count, packed.bytes(), reference, [&] { return packed.sumSimd(); });
+
+    timeDecode("delta scalar", count, delta.bytes(), reference, [&] { return delta.sumScalar(); });
+    if (avx2) timeDecode("delta AVX2", count, delta.bytes(), reference, [&] { return delta.sumSimd(); });
+}
@@ -0,0 +1,101 @@
+// ---------------------------------------------
+// AoS vs SoA – COMPRESSED COLUMNS
+// ---------------------------------------------
+
+// 1. WHY COMPRESS A COLUMN?
+/*
+   A sum over a SoA column is bandwidth-bound: the core waits on memory,
+   not on the adds. Once a field lives in its own array we can store it
+   in fewer bytes and decode it in registers on the fly – fewer bytes
+   from DRAM, a few extra instructions the core had spare anyway.
+*/
+
+// 2. WHICH ENCODINGS?
+/*
+   - Float16Column   : IEEE half precision, 2 bytes/value, decoded by F16C
+                       (vcvtph2ps). Lossy: ~3 significant digits.
+   - BitPackedColumn : value quantised to `bits`-bit integers over [min, max].
+                       Lossy: error ≤ (max - min) / 2^(bits+1).
+   - DeltaColumn     : value quantised to a fixed tick (e.g. 0.01), stored as
+                       zig-zag deltas with a per-block bit width. Lossless
+                       for tick data; a ±1-tick random walk needs ~4 bits/value.
+
+   Both integer codecs use VERTICAL bit packing in blocks of 256 values:
+   lane l of an 8-lane vector owns values l, l+8, l+16 ... so one AVX2
+   shift/mask step decodes 8 values with no gathers or shuffles.
+   DeltaColumn takes deltas against the value 8 positions back, so the
+   prefix sum is a plain vector add per step.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "huge_pages.hpp"
+
+constexpr size_t PACK_LANES = 8;
+constexpr size_t PACK_BLOCK = 256;
+constexpr size_t PACK_VALUES_PER_LANE = PACK_BLOCK / PACK_LANES;
+
+// Packs one block of 256 values (each < 2^bits) into bits * 8 words.
+void packBlock(const uint32_t* in, unsigned bits, uint32_t* out);
+// Scalar inverse of packBlock.
+void unpackBlock(const uint32_t* in, unsigned bits, uint32_t* out);
+
+class Float16Column {
+public:
+    Float16Column(const float* values, size_t count, PagePolicy policy);
+
+    float at(size_t i) const;
+    float sumScalar() const;
+    float sumSimd() const; // needs F16C + AVX2
+    size_t size() const { return count_; }
+    size_t bytes() const { return count_ * sizeof(uint16_t); }
+
+private:
+    size_t count_;
+    PageVector<uint16_t> halves_;
+};
+
+class BitPackedColumn {
+public:
+    BitPackedColumn(const float* values, size_t count, unsigned bits, PagePolicy policy);
+
+    float sumScalar() const;
+    float sumSimd() const; // needs AVX2
+    size_t size() const { return count_; }
+    size_t bytes() const { return words_.size() * sizeof(uint32_t) + tail_.size() * sizeof(float); }
+    unsigned bits() const { return bits_; }
+
+private:
+    size_t count_;
+    unsigned bits_;
+    float min_ = 0.0f;
+    float quantum_ = 1.0f;
+    PageVector<uint32_t> words_;
+    std::vector<float> tail_; // count % 256 values kept raw
+};
+
+class DeltaColumn {
+public:
+    DeltaColumn(const float* values, size_t count, float quantum, PagePolicy policy);
+
+    float sumScalar() const;
+    float sumSimd() const; // needs AVX2
+    size_t size() const { return count_; }
+    size_t bytes() const {
+        return words_.size() * sizeof(uint32_t) + blockBits_.size() + tail_.size() * sizeof(float);
+    }
+    double averageBits() const;
+
+private:
+    size_t count_;
+    float quantum_;
+    PageVector<uint32_t> words_;
+    std::vector<uint8_t> blockBits_;
+    std::vector<float> tail_;
+};
+
+void runCompressedColumns(size_t count, PagePolicy policy);
@@ -0,0 +1,262 @@
+#include "hot_cold_split.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "soa_vector.hpp"
+
+constexpr size_t RANDOM_LOOKUPS = 1'000'000;
+constexpr uint32_t SIDE_BUY = 0;
+
+// Hot fields first; everything from orderId on is cold.
+struct Order {
+    double price;
+    uint32_t quantity;
+    uint32_t side;
+
+    uint64_t orderId, clientId, accountId, parentId;
+    uint64_t createTime, updateTime, expireTime, symbol, routeTag;
+    double stopPrice, avgFillPrice, fee, notional;
+    uint64_t instrumentId, traderId;
+    uint32_t filledQty, displayQty, minQty, venue, strategy, flags;
+};
+static_assert(sizeof(Order) == 160, "Order should span 2.5 cache lines");
+
+struct OrderHot {
+    double price;
+    uint32_t quantity;
+    uint32_t side;
+};
+
+struct OrderCold {
+    uint64_t orderId, clientId, accountId, parentId;
+    uint64_t createTime, updateTime, expireTime, symbol, routeTag;
+    double stopPrice, avgFillPrice, fee, notional;
+    uint64_t instrumentId, traderId;
+    uint32_t filledQty, displayQty, minQty, venue, strategy, flags;
+};
+static_assert(sizeof(OrderHot) + sizeof(OrderCold) == sizeof(Order));
+
+// One column per Order member, in declaration order (recordAt<Order> relies on it).
+struct Price : soa_field<double> {};
+struct Quantity : soa_field<uint32_t> {};
+struct Side : soa_field<uint32_t> {};
+struct OrderId : soa_field<uint64_t> {};
+struct ClientId : soa_field<uint64_t> {};
+struct AccountId : soa_field<uint64_t> {};
+struct ParentId : soa_field<uint64_t> {};
+struct CreateTime : soa_field<uint64_t> {};
+struct UpdateTime : soa_field<uint64_t> {};
+struct ExpireTime : soa_field<uint64_t> {};
+struct Symbol : soa_field<uint64_t> {};
+struct RouteTag : soa_field<uint64_t> {};
+struct StopPrice : soa_field<double> {};
+struct AvgFillPrice : soa_field<double> {};
+struct Fee : soa_field<double> {};
+struct Notional : soa_field<double> {};
+struct InstrumentId : soa_field<uint64_t> {};
+struct TraderId : soa_field<uint64_t> {};
+struct FilledQty : soa_field<uint32_t> {};
+struct DisplayQty : soa_field<uint32_t> {};
+struct MinQty : soa_field<uint32_t> {};
+struct Venue : soa_field<uint32_t> {};
+struct Strategy : soa_field<uint32_t> {};
+struct Flags : soa_field<uint32_t> {};
+
+using OrdersSoA = soa_vector<Price, Quantity, Side, OrderId, ClientId, AccountId, ParentId, CreateTime,
+                             UpdateTime, ExpireTime, Symbol, RouteTag, StopPrice, AvgFillPrice, Fee, Notional,
+                             InstrumentId, TraderId, FilledQty, DisplayQty, MinQty, Venue, Strategy, Flags>;
+static_assert(OrdersSoA::NUM_FIELDS == 24);
+
+struct LayoutTimes {
+    double scan = 0, lookup = 0;
+};
+
+// Same seed for every layout, so all three hold identical orders.
+template<typename Store>
+void fillOrders(size_t count, Store store) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> price(99.0, 101.0);
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t r = rng();
+        Order o{};
+        o.price = price(rng);
+        o.quantity = static_cast<uint32_t>(r % 1000 + 1);
+        o.side = static_cast<uint32_t>((r >> 10) & 1);
+        o.orderId = i;
+        o.clientId = r >> 40;
+        o.accountId = r >> 32;
+        o.parentId = i / 4;
+        o.createTime = 1'700'000'000'000'000'000ull + i * 1000;
+        o.updateTime = o.createTime + (r & 0xffff);
+        o.expireTime = o.createTime + 86'400'000'000'000ull;
+        o.symbol = r % 5000;
+        o.routeTag = r ^ i;
+        o.stopPrice = o.price * 0.98;
+        o.avgFillPrice = o.price;
+        o.fee = o.quantity * 0.0001;
+        o.notional = o.price * o.quantity;
+        o.instrumentId = o.symbol * 7;
+        o.traderId = r % 97;
+        o.filledQty = o.quantity / 2;
+        o.displayQty = o.quantity;
+        o.minQty = 1;
+        o.venue = static_cast<uint32_t>(r % 12);
+        o.strategy = static_cast<uint32_t>(r % 31);
+        o.flags = static_cast<uint32_t>(r >> 56);
+        store(i, o);
+    }
+}
+
+// Folds every field, so a lookup can't skip any part of the record.
+double orderChecksum(const Order& o) {
+    uint64_t ints = o.quantity + o.side + o.orderId + o.clientId + o.accountId + o.parentId + o.createTime +
+                    o.updateTime + o.expireTime + o.symbol + o.routeTag + o.instrumentId + o.traderId +
+                    o.filledQty + o.displayQty + o.minQty + o.venue + o.strategy + o.flags;
+    return o.price + o.stopPrice + o.avgFillPrice + o.fee + o.notional + double(ints % 1024);
+}
+
+Order joinOrder(const OrderHot& hot, const OrderCold& cold) {
+    return Order{hot.price, hot.quantity, hot.side,
+                 cold.orderId, cold.clientId, cold.accountId, cold.parentId,
+                 cold.createTime, cold.updateTime, cold.expireTime, cold.symbol, cold.routeTag,
+                 cold.stopPrice, cold.avgFillPrice, cold.fee, cold.notional,
+                 cold.instrumentId, cold.traderId,
+                 cold.filledQty, cold.displayQty, cold.minQty, cold.venue, cold.strategy, cold.flags};
+}
+
+std::vector<size_t> randomOrderIds(size_t count) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<size_t> dist(0, count - 1);
+    std::vector<size_t> ids(RANDOM_LOOKUPS);
+    for (size_t& id : ids) id = dist(rng);
+    return ids;
+}
+
+template<typename Kernel>
+double timeOrders(const std::string& label, size_t ops, const char* unit, Kernel kernel) {
+    auto start = std::chrono::high_resolution_clock::now();
+    double checksum = kernel();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "   " << label << " took: " << static_cast<long long>(ms) << " ms, "
+              << ms * 1e6 / ops << " ns/" << unit << ", checksum: " << checksum << '\n';
+    return ms;
+}
+
+LayoutTimes runAoSOrders(size_t count, PagePolicy policy, const std::vector<size_t>& ids) {
+    PageVector<Order> orders(count, PageAllocator<Order>(policy));
+    fillOrders(count, [&](size_t i, const Order& o) { orders[i] = o; });
+    LayoutTimes t;
+
+    t.scan = timeOrders("AoS hot scan", count, "order", [&] {
+        double bids = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            if (orders[i].side == SIDE_BUY) bids += orders[i].price * orders[i].quantity;
+        }
+        return bids;
+    });
+
+    t.lookup = timeOrders("AoS full lookup", ids.size(), "lookup", [&] {
+        double sum = 0.0;
+        for (size_t id : ids) {
+            Order o = orders[id];
+            sum += orderChecksum(o);
+        }
+        return sum;
+    });
+
+    return t;
+}
+
+LayoutTimes runSplitOrders(size_t count, PagePolicy policy, const std::vector<size_t>& ids) {
+    PageVector<OrderHot> hot(count, PageAllocator<OrderHot>(policy));
+    PageVector<OrderCold> cold(count, PageAllocator<OrderCold>(policy));
+    fillOrders(count, [&](size_t i, const Order& o) {
+        hot[i] = {o.price, o.quantity, o.side};
+        cold[i] = {o.orderId, o.clientId, o.accountId, o.parentId,
+                   o.createTime, o.updateTime, o.expireTime, o.symbol, o.routeTag,
+                   o.stopPrice, o.avgFillPrice, o.fee, o.notional,
+                   o.instrumentId, o.traderId,
+                   o.filledQty, o.displayQty, o.minQty, o.venue, o.strategy, o.flags};
+    });
+    LayoutTimes t;
+
+    t.scan = timeOrders("hot/cold hot scan", count, "order", [&] {
+        double bids = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            if (hot[i].side == SIDE_BUY) bids += hot[i].price * hot[i].quantity;
+        }
+        return bids;
+    });
+
+    t.lookup = timeOrders("hot/cold full lookup", ids.size(), "lookup", [&] {
+        double sum = 0.0;
+        for (size_t id : ids) {
+            Order o = joinOrder(hot[id], cold[id]);
+            sum += orderChecksum(o);
+        }
+        return sum;
+    });
+
+    return t;
+}
+
+LayoutTimes runSoAOrders(size_t count, PagePolicy policy, const std::vector<size_t>& ids) {
+    OrdersSoA orders(policy);
+    orders.reserve(count);
+    fillOrders(count, [&](size_t, const Order& o) {
+        orders.push_back(o.price, o.quantity, o.side, o.orderId, o.clientId, o.accountId, o.parentId,
+                         o.createTime, o.updateTime, o.expireTime, o.symbol, o.routeTag,
+                         o.stopPrice, o.avgFillPrice, o.fee, o.notional, o.instrumentId, o.traderId,
+                         o.filledQty, o.displayQty, o.minQty, o.venue, o.strategy, o.flags);
+    });
+    LayoutTimes t;
+
+    auto price = orders.column<Price>();
+    auto quantity = orders.column<Quantity>();
+    auto side = orders.column<Side>();
+    t.scan = timeOrders("SoA hot scan", count, "order", [&] {
+        double bids = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            if (side[i] == SIDE_BUY) bids += price[i] * quantity[i];
+        }
+        return bids;
+    });
+
+    t.lookup = timeOrders("SoA full lookup", ids.size(), "lookup", [&] {
+        double sum = 0.0;
+        for (size_t id : ids) {
+            Order o = orders.recordAt<Order>(id);
+            sum += orderChecksum(o);
+        }
+        return sum;
+    });
+
+    return t;
+}
+
+void printRatios(const char* workload, double aos, double split, double soa) {
+    std::cout << "  " << workload << ": AoS " << static_cast<long long>(aos) << " ms, hot/cold "
+              << static_cast<long long>(split) << " ms (" << aos / split << "x), SoA "
+              << static_cast<long long>(soa) << " ms (" << aos / soa << "x)\n";
+}
+
+void runHotColdSplit(size_t count, PagePolicy policy) {
+    std::cout << "\n🔥 Hot/cold split over " << count << " orders (" << sizeof(Order) << " bytes, "
+              << OrdersSoA::NUM_FIELDS << " fields; hot part " << sizeof(OrderHot) << " bytes)\n";
+
+    std::vector<size_t> ids = randomOrderIds(count);
+    LayoutTimes aos = runAoSOrders(count, policy, ids);
+    LayoutTimes split = runSplitOrders(count, policy, ids);
+    LayoutTimes soa = runSoAOrders(count, policy, ids);
+
+    std::cout << "\n📊 Speedup over AoS:\n";
+    printRatios("hot scan    ", aos.scan, split.scan, soa.scan);
+    printRatios("full lookup ", aos.lookup, split.lookup, soa.lookup);
+}
@@ -0,0 +1,30 @@
+// ---------------------------------------------
+// AoS vs SoA – HOT/COLD SPLIT FOR WIDE RECORDS
+// ---------------------------------------------
+
+/*
+   ParticleAoS is 12 bytes, so AoS wastes little. A real order record is
+   100-200 bytes, yet the hot path (e.g. "notional of all resting bids")
+   reads only price, quantity and side. This mode uses a 160-byte, 24-field
+   Order and compares three layouts (./soa_vs_aos --mode=hotcold [--orders=N]):
+
+   - AoS      : PageVector<Order>, 160 bytes per order
+   - hot/cold : PageVector<OrderHot> (16 bytes: the 3 hot fields) plus an
+                index-aligned PageVector<OrderCold> side table (144 bytes)
+   - SoA      : soa_vector with 24 columns
+
+   on two workloads:
+   - hot scan     : sequential pass over price/quantity/side only
+   - full lookup  : random order id, copy out the whole 24-field record
+
+   The scan shows what the split buys (10x fewer bytes streamed); the lookup
+   shows what it costs (2 places in memory per order instead of 1, SoA: 24).
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+void runHotColdSplit(size_t count, PagePolicy policy);
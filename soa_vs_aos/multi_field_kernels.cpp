@@ -0,0 +1,219 @@
+#include "multi_field_kernels.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+constexpr float DT = 0.01f;
+constexpr float FILTER_RADIUS_SQ = 0.5f;
+constexpr size_t BLOCK_WIDTH = 8;
+
+struct BodyAoS {
+    float x, y, z, vx, vy, vz;
+};
+
+struct BodiesSoA {
+    PageVector<float> x, y, z, vx, vy, vz;
+
+    BodiesSoA(size_t n, PagePolicy policy)
+        : x(n, PageAllocator<float>(policy)), y(n, PageAllocator<float>(policy)),
+          z(n, PageAllocator<float>(policy)), vx(n, PageAllocator<float>(policy)),
+          vy(n, PageAllocator<float>(policy)), vz(n, PageAllocator<float>(policy)) {}
+};
+
+struct alignas(BLOCK_WIDTH * sizeof(float)) BodyBlock {
+    float x[BLOCK_WIDTH], y[BLOCK_WIDTH], z[BLOCK_WIDTH];
+    float vx[BLOCK_WIDTH], vy[BLOCK_WIDTH], vz[BLOCK_WIDTH];
+};
+
+// Slots past `count` in the last block stay zero; the filter never reads them.
+struct BodiesAoSoA {
+    PageVector<BodyBlock> blocks;
+    size_t count;
+
+    BodiesAoSoA(size_t n, PagePolicy policy)
+        : blocks((n + BLOCK_WIDTH - 1) / BLOCK_WIDTH, PageAllocator<BodyBlock>(policy)), count(n) {}
+};
+
+struct KernelTimes {
+    double norm = 0, update = 0, filter = 0;
+};
+
+// Same seed for every layout, so all three hold identical bodies.
+template<typename Store>
+void fillBodies(size_t count, Store store) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t i = 0; i < count; ++i) {
+        BodyAoS b{dist(rng), dist(rng), dist(rng), dist(rng), dist(rng), dist(rng)};
+        store(i, b);
+    }
+}
+
+template<typename Kernel>
+double timeKernel(const std::string& label, Kernel kernel) {
+    auto start = std::chrono::high_resolution_clock::now();
+    double checksum = kernel();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "   " << label << " took: " << static_cast<long long>(ms) << " ms, checksum: " << checksum << '\n';
+    return ms;
+}
+
+KernelTimes runAoSKernels(size_t count, PagePolicy policy) {
+    PageVector<BodyAoS> bodies(count, PageAllocator<BodyAoS>(policy));
+    fillBodies(count, [&](size_t i, const BodyAoS& b) { bodies[i] = b; });
+    KernelTimes t;
+
+    t.norm = timeKernel("AoS norm", [&] {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            const BodyAoS& b = bodies[i];
+            sum += std::sqrt(b.x * b.x + b.y * b.y + b.z * b.z);
+        }
+        return sum;
+    });
+
+    t.update = timeKernel("AoS update", [&] {
+        for (size_t i = 0; i < count; ++i) {
+            BodyAoS& b = bodies[i];
+            b.x += b.vx * DT;
+            b.y += b.vy * DT;
+            b.z += b.vz * DT;
+        }
+        return double(bodies[0].x);
+    });
+
+    PageVector<BodyAoS> kept(count, PageAllocator<BodyAoS>(policy));
+    t.filter = timeKernel("AoS filter", [&] {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const BodyAoS& b = bodies[i];
+            if (b.x * b.x + b.y * b.y + b.z * b.z < FILTER_RADIUS_SQ) kept[n++] = b;
+        }
+        return double(n);
+    });
+
+    return t;
+}
+
+KernelTimes runSoAKernels(size_t count, PagePolicy policy) {
+    BodiesSoA bodies(count, policy);
+    fillBodies(count, [&](size_t i, const BodyAoS& b) {
+        bodies.x[i] = b.x;   bodies.y[i] = b.y;   bodies.z[i] = b.z;
+        bodies.vx[i] = b.vx; bodies.vy[i] = b.vy; bodies.vz[i] = b.vz;
+    });
+    KernelTimes t;
+
+    t.norm = timeKernel("SoA norm", [&] {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += std::sqrt(bodies.x[i] * bodies.x[i] + bodies.y[i] * bodies.y[i] + bodies.z[i] * bodies.z[i]);
+        }
+        return sum;
+    });
+
+    t.update = timeKernel("SoA update", [&] {
+        for (size_t i = 0; i < count; ++i) {
+            bodies.x[i] += bodies.vx[i] * DT;
+            bodies.y[i] += bodies.vy[i] * DT;
+            bodies.z[i] += bodies.vz[i] * DT;
+        }
+        return double(bodies.x[0]);
+    });
+
+    BodiesSoA kept(count, policy);
+    t.filter = timeKernel("SoA filter", [&] {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            float x = bodies.x[i], y = bodies.y[i], z = bodies.z[i];
+            if (x * x + y * y + z * z < FILTER_RADIUS_SQ) {
+                kept.x[n] = x;                 kept.y[n] = y;                 kept.z[n] = z;
+                kept.vx[n] = bodies.vx[i];     kept.vy[n] = bodies.vy[i];     kept.vz[n] = bodies.vz[i];
+                ++n;
+            }
+        }
+        return double(n);
+    });
+
+    return t;
+}
+
+KernelTimes runAoSoAKernels(size_t count, PagePolicy policy) {
+    BodiesAoSoA bodies(count, policy);
+    fillBodies(count, [&](size_t i, const BodyAoS& b) {
+        BodyBlock& block = bodies.blocks[i / BLOCK_WIDTH];
+        size_t j = i % BLOCK_WIDTH;
+        block.x[j] = b.x;   block.y[j] = b.y;   block.z[j] = b.z;
+        block.vx[j] = b.vx; block.vy[j] = b.vy; block.vz[j] = b.vz;
+    });
+    KernelTimes t;
+
+    t.norm = timeKernel("AoSoA<8> norm", [&] {
+        double sum = 0.0;
+        for (const BodyBlock& block : bodies.blocks) {
+            for (size_t j = 0; j < BLOCK_WIDTH; ++j) {
+                sum += std::sqrt(block.x[j] * block.x[j] + block.y[j] * block.y[j] + block.z[j] * block.z[j]);
+            }
+        }
+        return sum;
+    });
+
+    t.update = timeKernel("AoSoA<8> update", [&] {
+        for (BodyBlock& block : bodies.blocks) {
+            for (size_t j = 0; j < BLOCK_WIDTH; ++j) {
+                block.x[j] += block.vx[j] * DT;
+                block.y[j] += block.vy[j] * DT;
+                block.z[j] += block.vz[j] * DT;
+            }
+        }
+        return double(bodies.blocks[0].x[0]);
+    });
+
+    BodiesAoSoA kept(count, policy);
+    t.filter = timeKernel("AoSoA<8> filter", [&] {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const BodyBlock& block = bodies.blocks[i / BLOCK_WIDTH];
+            size_t j = i % BLOCK_WIDTH;
+            float x = block.x[j], y = block.y[j], z = block.z[j];
+            if (x * x + y * y + z * z < FILTER_RADIUS_SQ) {
+                BodyBlock& out = kept.blocks[n / BLOCK_WIDTH];
+                size_t k = n % BLOCK_WIDTH;
+                out.x[k] = x;            out.y[k] = y;            out.z[k] = z;
+                out.vx[k] = block.vx[j]; out.vy[k] = block.vy[j]; out.vz[k] = block.vz[j];
+                ++n;
+            }
+        }
+        return double(n);
+    });
+
+    return t;
+}
+
+void printWinner(const char* kernel, double aos, double soa, double aosoa) {
+    const char* winner = "AoS";
+    double best = aos;
+    if (soa < best) { winner = "SoA"; best = soa; }
+    if (aosoa < best) { winner = "AoSoA<8>"; best = aosoa; }
+
+    std::cout << "  " << kernel << ": AoS " << static_cast<long long>(aos) << " ms, SoA "
+              << static_cast<long long>(soa) << " ms, AoSoA<8> " << static_cast<long long>(aosoa)
+              << " ms → 🏆 " << winner << " (SoA/AoS = " << soa / aos << ")\n";
+}
+
+void runMultiFieldKernels(size_t count, PagePolicy policy) {
+    std::cout << "\n🧮 Multi-field kernels over " << count << " bodies (6 floats each)\n";
+
+    KernelTimes aos = runAoSKernels(count, policy);
+    KernelTimes soa = runSoAKernels(count, policy);
+    KernelTimes aosoa = runAoSoAKernels(count, policy);
+
+    std::cout << "\n📊 Crossover summary:\n";
+    printWinner("norm   (3 fields)", aos.norm, soa.norm, aosoa.norm);
+    printWinner("update (6 fields)", aos.update, soa.update, aosoa.update);
+    printWinner("filter (3+6 fields)", aos.filter, soa.filter, aosoa.filter);
+}
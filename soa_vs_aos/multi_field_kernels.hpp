@@ -0,0 +1,22 @@
+// ---------------------------------------------
+// AoS vs SoA – MULTI-FIELD KERNELS
+// ---------------------------------------------
+
+/*
+   Summing only x is the best case for SoA. Real kernels touch several
+   fields, so this mode runs three of them on AoS, SoA and AoSoA<8>:
+
+   - norm   : sqrt(x² + y² + z²)             reads 3 of 6 fields
+   - update : x += vx*dt, y += vy*dt, ...    reads 6, writes 3
+   - filter : keep particles inside a sphere, compacted into a new array
+
+   and prints which layout wins each one (./soa_vs_aos --mode=kernels).
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+void runMultiFieldKernels(size_t count, PagePolicy policy);
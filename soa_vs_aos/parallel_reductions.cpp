@@ -0,0 +1,90 @@
+#include "parallel_reductions.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "particles.hpp"
+#include "thread_pool.hpp"
+
+struct alignas(64) PaddedPartial {
+    float value = 0.0f;
+};
+
+// Any deterministic non-zero pattern will do; it only has to defeat zero pages.
+inline float initialValue(size_t i) {
+    return static_cast<float>(i % 1024) * 0.001f;
+}
+
+// Times pool.run(task) and returns the aggregate GB/s for `bytes` streamed.
+double timeParallel(StaticThreadPool& pool, const std::string& label, size_t bytes,
+                    const std::vector<PaddedPartial>& partials, const std::function<void(size_t)>& task) {
+    auto start = std::chrono::high_resolution_clock::now();
+    pool.run(task);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    float sum = 0.0f;
+    for (const auto& p : partials) sum += p.value;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double gbPerSec = bytes / seconds / 1e9;
+    std::cout << "   " << label << " x" << pool.size() << " threads took: "
+              << static_cast<long long>(seconds * 1000) << " ms, " << gbPerSec << " GB/s, sum: " << sum << '\n';
+    return gbPerSec;
+}
+
+void runParallelReductions(size_t count, PagePolicy policy, size_t maxThreads) {
+    std::cout << "\n🧵 Parallel reductions over " << count << " particles (up to " << maxThreads << " threads)\n";
+
+    double aosBaseline = 0.0, soaBaseline = 0.0;
+
+    for (size_t threads = 1;; threads *= 2) {
+        threads = std::min(threads, maxThreads);
+        StaticThreadPool pool(threads);
+        std::vector<PaddedPartial> partials(threads);
+
+        // Allocation only reserves address space; the workers fault the pages in.
+        PageArray<ParticleAoS> aos(count, policy);
+        PageArray<float> soaX(count, policy), soaY(count, policy), soaZ(count, policy);
+
+        pool.run([&](size_t t) {
+            auto [begin, end] = staticPartition(count, t, threads);
+            for (size_t i = begin; i < end; ++i) {
+                float v = initialValue(i);
+                aos[i] = {v, v, v};
+                soaX[i] = v;
+                soaY[i] = v;
+                soaZ[i] = v;
+            }
+        });
+
+        double aosBw = timeParallel(pool, "❌ AoS read", count * sizeof(ParticleAoS), partials, [&](size_t t) {
+            auto [begin, end] = staticPartition(count, t, threads);
+            float sum = 0.0f;
+            for (size_t i = begin; i < end; ++i) {
+                sum += aos[i].x;
+            }
+            partials[t].value = sum;
+        });
+
+        double soaBw = timeParallel(pool, "✅ SoA read", count * sizeof(float), partials, [&](size_t t) {
+            auto [begin, end] = staticPartition(count, t, threads);
+            float sum = 0.0f;
+            for (size_t i = begin; i < end; ++i) {
+                sum += soaX[i];
+            }
+            partials[t].value = sum;
+        });
+
+        if (threads == 1) {
+            aosBaseline = aosBw;
+            soaBaseline = soaBw;
+        }
+        std::cout << "   → scaling vs 1 thread: AoS " << aosBw / aosBaseline << "x, SoA "
+                  << soaBw / soaBaseline << "x\n";
+
+        if (threads == maxThreads) break;
+    }
+}
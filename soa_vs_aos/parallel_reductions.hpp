@@ -0,0 +1,23 @@
+// ---------------------------------------------
+// AoS vs SoA – PARALLEL REDUCTIONS
+// ---------------------------------------------
+
+/*
+   One thread summing 1.2 GB uses a fraction of the machine's memory
+   bandwidth. This mode runs the AoS and SoA x-sums on 1, 2, 4 ... N
+   threads (./soa_vs_aos --mode=parallel [--threads=N]):
+
+   - a StaticThreadPool with pinned workers and static partitioning
+   - one cache-line padded partial sum per worker (no false sharing)
+   - parallel FIRST-TOUCH: each worker initialises its own slice, so on a
+     NUMA machine its pages are allocated on its own node
+   - aggregate GB/s and speedup over 1 thread for every thread count
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+void runParallelReductions(size_t count, PagePolicy policy, size_t maxThreads);
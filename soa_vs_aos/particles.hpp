@@ -0,0 +1,67 @@
+// ---------------------------------------------
+// AoS vs SoA – PARTICLE LAYOUTS
+// ---------------------------------------------
+
+/*
+   The particle layouts shared by every soa_vs_aos benchmark:
+   - ParticleAoS       : one struct per particle
+   - ParticlesSoA      : one page-backed array per field
+   - ParticlesAoSoA<W> : blocks of W particles, SoA inside each block
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+struct ParticleAoS {
+    float x, y, z;
+};
+
+// Columns are PageArrays: allocation only maps address space, nothing is
+// written until the caller fills the data (fresh pages read as zero).
+struct ParticlesSoA {
+    PageArray<float> x, y, z;
+
+    ParticlesSoA(size_t n, PagePolicy policy) : x(n, policy), y(n, policy), z(n, policy) {}
+};
+
+template<size_t Width>
+struct alignas(Width * sizeof(float)) ParticleBlock {
+    float x[Width], y[Width], z[Width];
+};
+
+// AoSoA: blocks of Width particles, each block laid out SoA.
+// The tail of the last block is zero-filled so kernels can always
+// process whole blocks (zeros don't change sums).
+template<size_t Width>
+struct ParticlesAoSoA {
+    PageVector<ParticleBlock<Width>> blocks;
+    size_t count;
+
+    ParticlesAoSoA(size_t n, PagePolicy policy)
+        : blocks((n + Width - 1) / Width, PageAllocator<ParticleBlock<Width>>(policy)), count(n) {}
+
+    static ParticlesAoSoA fromAoS(const PageVector<ParticleAoS>& particles, PagePolicy policy) {
+        ParticlesAoSoA out(particles.size(), policy);
+        for (size_t i = 0; i < particles.size(); ++i) {
+            auto& block = out.blocks[i / Width];
+            block.x[i % Width] = particles[i].x;
+            block.y[i % Width] = particles[i].y;
+            block.z[i % Width] = particles[i].z;
+        }
+        return out;
+    }
+
+    static ParticlesAoSoA fromSoA(const ParticlesSoA& particles, PagePolicy policy) {
+        ParticlesAoSoA out(particles.x.size(), policy);
+        for (size_t i = 0; i < particles.x.size(); ++i) {
+            auto& block = out.blocks[i / Width];
+            block.x[i % Width] = particles.x[i];
+            block.y[i % Width] = particles.y[i];
+            block.z[i % Width] = particles.z[i];
+        }
+        return out;
+    }
+};
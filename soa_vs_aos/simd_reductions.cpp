@@ -0,0 +1,242 @@
+#include "simd_reductions.hpp"
+
+#include <immintrin.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+#include "particles.hpp"
+
+SimdLevel detectSimdLevel() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+    return SimdLevel::Scalar;
+}
+
+SimdLevel parseSimdLevel(const std::string& name) {
+    if (name == "auto") return detectSimdLevel();
+    if (name == "scalar") return SimdLevel::Scalar;
+    if (name == "avx2") return SimdLevel::Avx2;
+    if (name == "avx512") return SimdLevel::Avx512;
+    throw std::invalid_argument("unknown SIMD level '" + name + "' (expected auto, scalar, avx2 or avx512)");
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::Avx2:   return "AVX2";
+        case SimdLevel::Avx512: return "AVX-512";
+    }
+    return "?";
+}
+
+// ---- scalar ----
+
+float sumColumnStrict(const float* x, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) sum += x[i];
+    return sum;
+}
+
+float sumStridedStrict(const float* base, size_t n, size_t stride) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) sum += base[i * stride];
+    return sum;
+}
+
+// Four scalar accumulators: no SIMD, but four adds in flight instead of one.
+static float sumColumnUnrolled(const float* x, size_t n) {
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += x[i];
+        s1 += x[i + 1];
+        s2 += x[i + 2];
+        s3 += x[i + 3];
+    }
+    for (; i < n; ++i) s0 += x[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+static float sumStridedUnrolled(const float* base, size_t n, size_t stride) {
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += base[i * stride];
+        s1 += base[(i + 1) * stride];
+        s2 += base[(i + 2) * stride];
+        s3 += base[(i + 3) * stride];
+    }
+    for (; i < n; ++i) s0 += base[i * stride];
+    return (s0 + s1) + (s2 + s3);
+}
+
+// ---- AVX2 ----
+
+__attribute__((target("avx2")))
+static float horizontalSum(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    lo = _mm_add_ps(lo, hi);
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+    return _mm_cvtss_f32(lo);
+}
+
+__attribute__((target("avx2")))
+static float sumColumnAvx2(const float* x, size_t n) {
+    __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+    __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        a0 = _mm256_add_ps(a0, _mm256_loadu_ps(x + i));
+        a1 = _mm256_add_ps(a1, _mm256_loadu_ps(x + i + 8));
+        a2 = _mm256_add_ps(a2, _mm256_loadu_ps(x + i + 16));
+        a3 = _mm256_add_ps(a3, _mm256_loadu_ps(x + i + 24));
+    }
+    float sum = horizontalSum(_mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3)));
+    for (; i < n; ++i) sum += x[i];
+    return sum;
+}
+
+__attribute__((target("avx2")))
+static float sumStridedAvx2(const float* base, size_t n, size_t stride) {
+    const int s = static_cast<int>(stride);
+    const __m256i index = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+    __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        a0 = _mm256_add_ps(a0, _mm256_i32gather_ps(base + i * stride, index, 4));
+        a1 = _mm256_add_ps(a1, _mm256_i32gather_ps(base + (i + 8) * stride, index, 4));
+    }
+    float sum = horizontalSum(_mm256_add_ps(a0, a1));
+    for (; i < n; ++i) sum += base[i * stride];
+    return sum;
+}
+
+// ---- AVX-512 ----
+
+__attribute__((target("avx512f")))
+static float sumColumnAvx512(const float* x, size_t n) {
+    __m512 a0 = _mm512_setzero_ps(), a1 = _mm512_setzero_ps();
+    __m512 a2 = _mm512_setzero_ps(), a3 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        a0 = _mm512_add_ps(a0, _mm512_loadu_ps(x + i));
+        a1 = _mm512_add_ps(a1, _mm512_loadu_ps(x + i + 16));
+        a2 = _mm512_add_ps(a2, _mm512_loadu_ps(x + i + 32));
+        a3 = _mm512_add_ps(a3, _mm512_loadu_ps(x + i + 48));
+    }
+    float sum = _mm512_reduce_add_ps(_mm512_add_ps(_mm512_add_ps(a0, a1), _mm512_add_ps(a2, a3)));
+    for (; i < n; ++i) sum += x[i];
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+static float sumStridedAvx512(const float* base, size_t n, size_t stride) {
+    const int s = static_cast<int>(stride);
+    const __m512i index = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(s));
+    __m512 a0 = _mm512_setzero_ps(), a1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        a0 = _mm512_add_ps(a0, _mm512_i32gather_ps(index, base + i * stride, 4));
+        a1 = _mm512_add_ps(a1, _mm512_i32gather_ps(index, base + (i + 16) * stride, 4));
+    }
+    float sum = _mm512_reduce_add_ps(_mm512_add_ps(a0, a1));
+    for (; i < n; ++i) sum += base[i * stride];
+    return sum;
+}
+
+ColumnSumFn selectColumnSum(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return sumColumnAvx512;
+        case SimdLevel::Avx2:   return sumColumnAvx2;
+        case SimdLevel::Scalar: return sumColumnUnrolled;
+    }
+    return sumColumnStrict;
+}
+
+StridedSumFn selectStridedSum(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return sumStridedAvx512;
+        case SimdLevel::Avx2:   return sumStridedAvx2;
+        case SimdLevel::Scalar: return sumStridedUnrolled;
+    }
+    return sumStridedStrict;
+}
+
+// ---- benchmark ----
+
+// Accuracy reference for every kernel, strict one included. A float running
+// sum of ~1e8 values in [0, 1) stalls near 2^24, where adding anything below
+// 1.0 no longer changes it; a double accumulator stays exact to ~1e-8 here.
+double referenceSum(const float* base, size_t n, size_t stride) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) sum += base[i * stride];
+    return sum;
+}
+
+template<typename Kernel>
+float timeReduction(const std::string& label, size_t bytes, double reference, Kernel kernel) {
+    auto start = std::chrono::high_resolution_clock::now();
+    float sum = kernel();
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "   " << label << " took: " << static_cast<long long>(seconds * 1000) << " ms, "
+              << bytes / seconds / 1e9 << " GB/s, sum: " << sum
+              << ", rel. error vs double: " << std::fabs(sum - reference) / std::fabs(reference) << '\n';
+    return sum;
+}
+
+void runSimdReductions(size_t count, PagePolicy policy, const std::string& simd, bool strict) {
+    SimdLevel detected = detectSimdLevel();
+    SimdLevel requested = parseSimdLevel(simd);
+    if (requested > detected) {
+        std::cerr << simdLevelName(requested) << " requested but this CPU only supports "
+                  << simdLevelName(detected) << ", falling back.\n";
+        requested = detected;
+    }
+
+    std::cout << "\n⚡ SIMD reductions over " << count << " particles (CPU supports "
+              << simdLevelName(detected) << ")\n";
+
+    // Random positive data; an all-zero sum would hide the rounding differences.
+    PageVector<ParticleAoS> aos(count, PageAllocator<ParticleAoS>(policy));
+    ParticlesSoA soa(count, policy);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (size_t i = 0; i < count; ++i) {
+        aos[i] = {dist(rng), dist(rng), dist(rng)};
+        soa.x[i] = aos[i].x;
+        soa.y[i] = aos[i].y;
+        soa.z[i] = aos[i].z;
+    }
+
+    const float* aosBase = &aos[0].x;
+    constexpr size_t STRIDE = sizeof(ParticleAoS) / sizeof(float);
+    size_t soaBytes = count * sizeof(float);
+    size_t aosBytes = count * sizeof(ParticleAoS);
+
+    double soaReference = referenceSum(soa.x.data(), count, 1);
+    double aosReference = referenceSum(aosBase, count, STRIDE);
+
+    timeReduction("SoA scalar strict", soaBytes, soaReference, [&] { return sumColumnStrict(soa.x.data(), count); });
+    timeReduction("AoS scalar strict", aosBytes, aosReference, [&] { return sumStridedStrict(aosBase, count, STRIDE); });
+    if (strict) return;
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (level > requested) break;
+        std::string name = level == SimdLevel::Scalar ? "4-acc scalar" : simdLevelName(level);
+        ColumnSumFn column = selectColumnSum(level);
+        StridedSumFn strided = selectStridedSum(level);
+
+        timeReduction("SoA " + name, soaBytes, soaReference, [&] { return column(soa.x.data(), count); });
+        timeReduction("AoS " + name + (level == SimdLevel::Scalar ? "" : " gather"), aosBytes, aosReference,
+                      [&] { return strided(aosBase, count, STRIDE); });
+    }
+}
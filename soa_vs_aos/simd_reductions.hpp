@@ -0,0 +1,52 @@
+// ---------------------------------------------
+// AoS vs SoA – EXPLICIT SIMD REDUCTIONS
+// ---------------------------------------------
+
+// 1. WHY HAND-WRITTEN SIMD?
+/*
+   `sum += x[i]` is a chain of dependent float adds. Float addition isn't
+   associative, so without -ffast-math the compiler must keep that exact
+   order – one lane, one add per cycle of latency, no vectorization.
+   That hides the main thing SoA buys us: contiguous data for SIMD.
+*/
+
+// 2. WHAT DO WE DO INSTEAD?
+/*
+   - SoA: 4 independent vector accumulators (AVX2: 4×8 lanes, AVX-512: 4×16)
+     so several adds are in flight, combined once at the end
+   - AoS: the same, but x is every 3rd float, so lanes are filled with gathers
+   - The ISA is picked at runtime from CPUID (__builtin_cpu_supports), so one
+     binary runs everywhere; --simd=scalar|avx2|avx512 forces a level
+
+   Reordering the adds changes the rounding, so results differ in the last
+   bits between levels. --strict runs only the sequential scalar loop, which
+   is bit-for-bit reproducible on any machine – but not accurate: at large
+   counts its float sum saturates. Every kernel's error is therefore
+   measured against a double-precision sum of the same data.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "huge_pages.hpp"
+
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+SimdLevel detectSimdLevel();
+SimdLevel parseSimdLevel(const std::string& name); // "auto", "scalar", "avx2", "avx512"
+const char* simdLevelName(SimdLevel level);
+
+// Sum of n contiguous floats (SoA column).
+using ColumnSumFn = float (*)(const float* x, size_t n);
+// Sum of the first float of n records spaced `stride` floats apart (AoS field).
+using StridedSumFn = float (*)(const float* base, size_t n, size_t stride);
+
+float sumColumnStrict(const float* x, size_t n);
+float sumStridedStrict(const float* base, size_t n, size_t stride);
+
+ColumnSumFn selectColumnSum(SimdLevel level);
+StridedSumFn selectStridedSum(SimdLevel level);
+
+void runSimdReductions(size_t count, PagePolicy policy, const std::string& simd, bool strict);
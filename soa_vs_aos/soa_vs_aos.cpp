@@ -72,57 +72,381 @@
    - AoS is easier but may be slower
    - In HFT, using SoA can improve latency for batch operations
 */
+
+
+// 7. WHAT ABOUT THE TLB?
+/*
+   The AoS array is 1.2 GB and each SoA column 400 MB – on 4K pages a
+   sequential read takes a dTLB miss every 4 KB. Run with --pages=thp|2m|1g
+   to back the containers with huge pages; dTLB misses are printed per run.
+*/
+
+
+// 8. DO WE HAVE TO HAND-WRITE EVERY SoA?
+/*
+   No. soa_vector<Fields...> (common/soa_vector.hpp) builds the columns from
+   field tags in one allocation and still lets code walk it like AoS:
+       for (auto [x, y, z] : particles) ...
+   It is benchmarked here both column-wise and through that proxy.
+*/
+
+
+// 9. IS THERE SOMETHING IN BETWEEN?
+/*
+   AoSoA (Array of Structs of Arrays):
+       struct Block { float x[8], y[8], z[8]; };
+       Block blocks[N / 8];
+
+   Each block is one SIMD register's worth of x, then y, then z.
+   A kernel that reads one field still streams mostly useful bytes,
+   and a kernel that reads x, y and z together finds them in the same
+   few cache lines instead of three separate streams.
+   Both the single-field (x) and all-field (x+y+z) kernels run on every layout.
+*/
+
+
+// 10. WHAT ABOUT REAL KERNELS?
+/*
+   Most real work touches several fields at once. --mode=kernels runs
+   norm / position update / filter kernels on 6-field bodies in AoS, SoA
+   and AoSoA<8> and reports the winner of each (multi_field_kernels.cpp).
+   --particles=N shrinks or grows the arrays for any mode.
+*/
+
+
+// 11. AND THE SIMD HEADROOM?
+/*
+   The plain `sum += x[i]` loops can't vectorize (float adds must stay in
+   order). --mode=simd runs hand-written AVX2 / AVX-512 reductions picked at
+   runtime from CPUID, plus gather-based AoS versions, next to the strict
+   scalar loop (simd_reductions.cpp). --strict keeps only the reproducible one.
+*/
+
+
+// 12. HOW MUCH BANDWIDTH IS LEFT ON THE TABLE?
+/*
+   --mode=parallel [--threads=N] repeats the AoS/SoA sums on a pinned thread
+   pool with parallel first-touch and reports GB/s scaling per thread count
+   (parallel_reductions.cpp).
+*/
+
+
+// 13. ARE WE MEASURING THE LAYOUT OR THE PAGE FAULTS?
+/*
+   A zero-initialised 1.2 GB vector pays every page fault up front, then the
+   "read" phase sums zeros – and SoA pays its faults in three separate
+   resizes. So the default run now reports three phases per layout:
+   - allocation  : mmap only, no page is touched
+   - first-touch : random data written into fresh pages (minor faults shown)
+   - read        : the steady-state kernels on non-trivial data
+*/
+
+
+// 14. CAN WE MOVE FEWER BYTES?
+/*
+   A column sum is bound by DRAM bandwidth, so storing the column smaller
+   and decoding it in registers can beat reading raw floats.
+   --mode=compressed compares float16, 16-bit quantised and delta-encoded
+   columns on tick-like prices (compressed_column.hpp).
+*/
+
+
+// 15. WHAT IF THE RECORD IS WIDE?
+/*
+   Order records are 100-200 bytes with 2-3 fields on the hot path.
+   --mode=hotcold [--orders=N] compares a 160-byte AoS order, a hot struct
+   plus cold side table, and a 24-column SoA on a hot-field scan and on
+   random full-record lookups (hot_cold_split.hpp).
+*/
+
+
+// 16. WHAT IF THE DATA ARRIVES AS AoS?
+/*
+   Wire formats are packed records. --mode=transpose [--records=N] converts
+   3-, 4- and 8-float records to columns and back with AVX2 shuffles, and
+   reports after how many kernel passes the conversion has paid for itself
+   (transpose.hpp).
+*/
+
+
+// 17. AND WHEN WE HAVE TO REORDER?
+/*
+   --mode=sort sorts by x as whole AoS records, as an SoA index permutation
+   plus gather, and with an SoA key/index radix sort, printing time and
+   estimated memory traffic for each (sort_layouts.hpp).
+*/
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sys/resource.h>
 
-constexpr size_t NUM_PARTICLES = 100'000'000;
+#include "bench_options.hpp"
+#include "compressed_column.hpp"
+#include "fast_random.hpp"
+#include "hot_cold_split.hpp"
+#include "huge_pages.hpp"
+#include "multi_field_kernels.hpp"
+#include "parallel_reductions.hpp"
+#include "particles.hpp"
+#include "perf_counters.hpp"
+#include "simd_reductions.hpp"
+#include "soa_vector.hpp"
+#include "sort_layouts.hpp"
+#include "thread_affinity.hpp"
+#include "transpose.hpp"
 
-struct ParticleAoS {
-    float x, y, z;
-};
+constexpr size_t NUM_PARTICLES = 100'000'000;
+constexpr size_t NUM_ORDERS = 5'000'000; // 160 bytes each
+constexpr size_t NUM_RECORDS = 10'000'000;
 
-struct ParticlesSoA {
-    std::vector<float> x, y, z;
+struct PosX : soa_field<float> {};
+struct PosY : soa_field<float> {};
+struct PosZ : soa_field<float> {};
 
-    ParticlesSoA(size_t n) {
-        x.resize(n);
-        y.resize(n);
-        z.resize(n);
-    }
-};
+using ParticlesSoAVector = soa_vector<PosX, PosY, PosZ>;
 
-void runAoSBenchmark() {
-    std::vector<ParticleAoS> particles(NUM_PARTICLES);
+// Times one read kernel (returning its sum) and prints it in the module's format.
+template<typename Kernel>
+void timeRead(const std::string& label, Kernel kernel) {
+    PerfCounter dtlbMisses(PerfEvent::DtlbLoadMisses);
 
+    dtlbMisses.start();
     auto start = std::chrono::high_resolution_clock::now();
-    float sum = 0.0f;
-    for (size_t i = 0; i < NUM_PARTICLES; ++i) {
-        sum += particles[i].x;
-    }
+    float sum = kernel();
     auto end = std::chrono::high_resolution_clock::now();
+    long long misses = dtlbMisses.stop();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
-    std::cout << "❌ AoS read took: " << ms << " ms, sum: " << sum << '\n';
+    std::cout << label << " took: " << ms << " ms, dTLB misses: " << formatCount(misses)
+              << ", sum: " << sum << '\n';
 }
 
-void runSoABenchmark() {
-    ParticlesSoA particles(NUM_PARTICLES);
+long minorPageFaults() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
 
+template<typename Phase>
+void timePhase(const std::string& label, Phase phase) {
+    long faults = minorPageFaults();
     auto start = std::chrono::high_resolution_clock::now();
-    float sum = 0.0f;
-    for (size_t i = 0; i < NUM_PARTICLES; ++i) {
-        sum += particles.x[i];
-    }
+    phase();
     auto end = std::chrono::high_resolution_clock::now();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
-    std::cout << "✅ SoA read took: " << ms << " ms, sum: " << sum << '\n';
+    std::cout << label << " took: " << ms << " ms, minor page faults: " << minorPageFaults() - faults << '\n';
+}
+
+void runAoSBenchmark(size_t count, PagePolicy policy) {
+    std::unique_ptr<PageArray<ParticleAoS>> storage;
+
+    timePhase("   AoS allocation", [&] { storage = std::make_unique<PageArray<ParticleAoS>>(count, policy); });
+    PageArray<ParticleAoS>& particles = *storage;
+
+    timePhase("   AoS first-touch", [&] {
+        FastRandom rng(42);
+        for (size_t i = 0; i < count; ++i) {
+            particles[i].x = rng.unit();
+            particles[i].y = rng.unit();
+            particles[i].z = rng.unit();
+        }
+    });
+
+    timeRead("❌ AoS read", [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            sum += particles[i].x;
+        }
+        return sum;
+    });
+
+    timeRead("   AoS read x+y+z", [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            sum += particles[i].x + particles[i].y + particles[i].z;
+        }
+        return sum;
+    });
 }
 
-int main() {
-    std::cout << "🔍 Benchmarking AoS vs SoA...\n";
-    runAoSBenchmark();
-    runSoABenchmark();
+void runSoABenchmark(size_t count, PagePolicy policy) {
+    std::unique_ptr<ParticlesSoA> storage;
+
+    timePhase("   SoA allocation", [&] { storage = std::make_unique<ParticlesSoA>(count, policy); });
+    ParticlesSoA& particles = *storage;
+
+    // Same generator and order as AoS, so both layouts hold identical particles.
+    timePhase("   SoA first-touch", [&] {
+        FastRandom rng(42);
+        for (size_t i = 0; i < count; ++i) {
+            particles.x[i] = rng.unit();
+            particles.y[i] = rng.unit();
+            particles.z[i] = rng.unit();
+        }
+    });
+
+    timeRead("✅ SoA read", [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            sum += particles.x[i];
+        }
+        return sum;
+    });
+
+    timeRead("   SoA read x+y+z", [&] {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            sum += particles.x[i] + particles.y[i] + particles.z[i];
+        }
+        return sum;
+    });
+}
+
+void runSoAVectorBenchmark(size_t count, PagePolicy policy) {
+    ParticlesSoAVector particles(count, policy);
+    FastRandom rng(42);
+    for (auto [x, y, z] : particles) {
+        x = rng.unit();
+        y = rng.unit();
+        z = rng.unit();
+    }
+
+    timeRead("✅ soa_vector column read", [&] {
+        float sum = 0.0f;
+        for (float x : particles.column<PosX>()) {
+            sum += x;
+        }
+        return sum;
+    });
+
+    timeRead("✅ soa_vector proxy read", [&] {
+        float sum = 0.0f;
+        for (auto [x, y, z] : particles) {
+            sum += x;
+        }
+        return sum;
+    });
+}
+
+template<size_t Width>
+void runAoSoABenchmark(size_t count, PagePolicy policy) {
+    std::string name = "AoSoA<" + std::to_string(Width) + ">";
+    ParticlesAoSoA<Width> particles = [&] {
+        PageVector<ParticleAoS> source(count, PageAllocator<ParticleAoS>(policy));
+        FastRandom rng(42);
+        for (ParticleAoS& p : source) p = {rng.unit(), rng.unit(), rng.unit()};
+
+        ParticlesSoA columns(count, policy);
+        for (size_t i = 0; i < count; ++i) {
+            columns.x[i] = source[i].x;
+            columns.y[i] = source[i].y;
+            columns.z[i] = source[i].z;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto converted = ParticlesAoSoA<Width>::fromAoS(source, policy);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "   " << name << " conversion from AoS took: "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+
+        start = std::chrono::high_resolution_clock::now();
+        auto fromColumns = ParticlesAoSoA<Width>::fromSoA(columns, policy);
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "   " << name << " conversion from SoA took: "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+
+        // Both conversions must produce the same blocks, zero-filled tail included.
+        bool same = std::equal(converted.blocks.begin(), converted.blocks.end(), fromColumns.blocks.begin(),
+                               [](const ParticleBlock<Width>& a, const ParticleBlock<Width>& b) {
+                                   return std::memcmp(&a, &b, sizeof(a)) == 0;
+                               });
+        if (!same) std::cout << "   ❌ " << name << " from SoA doesn't match from AoS\n";
+        return converted;
+    }();
+
+    timeRead("✅ " + name + " read", [&] {
+        float sum = 0.0f;
+        for (const auto& block : particles.blocks) {
+            for (size_t j = 0; j < Width; ++j) {
+                sum += block.x[j];
+            }
+        }
+        return sum;
+    });
+
+    timeRead("✅ " + name + " read x+y+z", [&] {
+        float sum = 0.0f;
+        for (const auto& block : particles.blocks) {
+            for (size_t j = 0; j < Width; ++j) {
+                sum += block.x[j] + block.y[j] + block.z[j];
+            }
+        }
+        return sum;
+    });
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options(argc, argv);
+    PagePolicy policy;
+    try {
+        policy = parsePagePolicy(options.get("pages", "4k"));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << "🔍 Benchmarking AoS vs SoA (" << pagePolicyName(policy) << ")...\n";
+    size_t count = options.getSize("particles", NUM_PARTICLES);
+    std::string mode = options.get("mode", "read");
+    if (mode == "kernels") {
+        runMultiFieldKernels(count, policy);
+        return 0;
+    }
+    if (mode == "parallel") {
+        runParallelReductions(count, policy, std::max<size_t>(1, options.getSize("threads", cpuCount())));
+        return 0;
+    }
+    if (mode == "hotcold") {
+        runHotColdSplit(std::max<size_t>(1, options.getSize("orders", NUM_ORDERS)), policy);
+        return 0;
+    }
+    if (mode == "compressed") {
+        runCompressedColumns(count, policy);
+        return 0;
+    }
+    if (mode == "sort") {
+        runSortBenchmark(count, policy);
+        return 0;
+    }
+    if (mode == "transpose") {
+        try {
+            runTransposeBenchmark(options.getSize("records", NUM_RECORDS), policy, options.get("simd", "auto"));
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (mode == "simd") {
+        try {
+            runSimdReductions(count, policy, options.get("simd", "auto"), options.has("strict"));
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    runAoSBenchmark(count, policy);
+    runSoABenchmark(count, policy);
+    runSoAVectorBenchmark(count, policy);
+    runAoSoABenchmark<8>(count, policy);
+    runAoSoABenchmark<16>(count, policy);
     return 0;
 }
@@ -0,0 +1,160 @@
+#include "sort_layouts.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "particles.hpp"
+#include "perf_counters.hpp"
+
+constexpr size_t RADIX_BITS = 8;
+constexpr size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+constexpr size_t RADIX_PASSES = 32 / RADIX_BITS;
+constexpr size_t CACHE_LINE = 64;
+
+// Same seed for both layouts, so they sort identical particles.
+template<typename Store>
+void fillParticles(size_t count, Store store) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t i = 0; i < count; ++i) store(i, ParticleAoS{dist(rng), dist(rng), dist(rng)});
+}
+
+// Maps a float to an unsigned key with the same order: negative values get
+// all bits flipped, positive ones just the sign bit.
+uint32_t radixKey(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+// LSD radix sort of `keys`, carrying `index` along; both end up sorted in place.
+// The scratch vectors must be the same size; the caller allocates them so
+// their page faults stay out of the timed region.
+void radixSortPairs(PageVector<uint32_t>& keys, PageVector<uint32_t>& index,
+                    PageVector<uint32_t>& keysTmp, PageVector<uint32_t>& indexTmp) {
+    size_t n = keys.size();
+
+    for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+        unsigned shift = pass * RADIX_BITS;
+        size_t offsets[RADIX_BUCKETS] = {};
+        for (uint32_t k : keys) ++offsets[(k >> shift) & (RADIX_BUCKETS - 1)];
+
+        size_t running = 0;
+        for (size_t& o : offsets) running += std::exchange(o, running);
+
+        for (size_t i = 0; i < n; ++i) {
+            size_t dst = offsets[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            keysTmp[dst] = keys[i];
+            indexTmp[dst] = index[i];
+        }
+        keys.swap(keysTmp);
+        index.swap(indexTmp);
+    }
+}
+
+void gatherColumns(const ParticlesSoA& in, const PageVector<uint32_t>& order, ParticlesSoA& out) {
+    for (size_t i = 0; i < order.size(); ++i) {
+        uint32_t src = order[i];
+        out.x[i] = in.x[src];
+        out.y[i] = in.y[src];
+        out.z[i] = in.z[src];
+    }
+}
+
+template<typename Sort>
+void timeSort(const std::string& label, double modelBytes, Sort sort) {
+    PerfCounter llcMisses(PerfEvent::LlcLoadMisses);
+
+    llcMisses.start();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort();
+    auto end = std::chrono::high_resolution_clock::now();
+    long long misses = llcMisses.stop();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << "   " << label << " took: " << ms << " ms, est. traffic: " << static_cast<long long>(modelBytes / 1e6)
+              << " MB, LLC-miss traffic: ";
+    if (misses < 0) std::cout << "n/a\n";
+    else std::cout << misses * CACHE_LINE / 1'000'000 << " MB\n";
+}
+
+template<typename Keys>
+bool isSortedBy(size_t count, Keys key) {
+    for (size_t i = 1; i < count; ++i) {
+        if (key(i) < key(i - 1)) return false;
+    }
+    return true;
+}
+
+void runSortBenchmark(size_t count, PagePolicy policy) {
+    std::cout << "\n🔢 Sorting " << count << " particles by x\n";
+
+    double n = static_cast<double>(count);
+    double passes = std::max(1.0, std::ceil(std::log2(n)));
+    // Comparison sorts: each element read + written once per log2(n) pass.
+    // Gather: 4 B of index, 12 B of scattered reads and 12 B of writes.
+    double gatherBytes = n * (sizeof(uint32_t) + 2 * sizeof(ParticleAoS));
+    double aosModel = n * passes * 2 * sizeof(ParticleAoS);
+    double indexModel = n * passes * (2 * sizeof(uint32_t) + 2 * sizeof(float)) + gatherBytes;
+    // Radix: key build (read x, write key + index), then per pass a histogram
+    // read of the keys and a read + scatter-write of (key, index).
+    double radixModel = n * 3 * sizeof(uint32_t) + RADIX_PASSES * n * 5 * sizeof(uint32_t) + gatherBytes;
+
+    PageVector<float> aosKeys{PageAllocator<float>(policy)};
+    {
+        PageVector<ParticleAoS> aos(count, PageAllocator<ParticleAoS>(policy));
+        fillParticles(count, [&](size_t i, const ParticleAoS& p) { aos[i] = p; });
+
+        timeSort("AoS std::sort (records)", aosModel, [&] {
+            std::sort(aos.begin(), aos.end(), [](const ParticleAoS& a, const ParticleAoS& b) { return a.x < b.x; });
+        });
+        aosKeys.resize(count);
+        for (size_t i = 0; i < count; ++i) aosKeys[i] = aos[i].x;
+    }
+
+    ParticlesSoA soa(count, policy);
+    fillParticles(count, [&](size_t i, const ParticleAoS& p) {
+        soa.x[i] = p.x;
+        soa.y[i] = p.y;
+        soa.z[i] = p.z;
+    });
+    // Both SoA runs gather into the same target. It is faulted in up front so
+    // neither timed region pays its first touch.
+    ParticlesSoA sorted(count, policy);
+    for (PageArray<float>* column : {&sorted.x, &sorted.y, &sorted.z}) {
+        prefaultPages(column->data(), count * sizeof(float), policy);
+    }
+    PageVector<uint32_t> order(count, PageAllocator<uint32_t>(policy));
+
+    timeSort("SoA index sort + gather", indexModel, [&] {
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return soa.x[a] < soa.x[b]; });
+        gatherColumns(soa, order, sorted);
+    });
+    bool indexOk = std::equal(aosKeys.begin(), aosKeys.end(), sorted.x.data());
+
+    PageVector<uint32_t> keys(count, PageAllocator<uint32_t>(policy));
+    PageVector<uint32_t> keysTmp(count, PageAllocator<uint32_t>(policy));
+    PageVector<uint32_t> indexTmp(count, PageAllocator<uint32_t>(policy));
+    timeSort("SoA radix sort + gather", radixModel, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            keys[i] = radixKey(soa.x[i]);
+            order[i] = static_cast<uint32_t>(i);
+        }
+        radixSortPairs(keys, order, keysTmp, indexTmp);
+        gatherColumns(soa, order, sorted);
+    });
+    // std::sort isn't stable, so compare against the AoS keys only.
+    bool radixOk = std::equal(aosKeys.begin(), aosKeys.end(), sorted.x.data());
+
+    std::cout << "   " << (indexOk && radixOk && isSortedBy(count, [&](size_t i) { return aosKeys[i]; }) ? "✅" : "❌")
+              << " all three produce the same order of x\n";
+}
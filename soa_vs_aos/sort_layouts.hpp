@@ -0,0 +1,28 @@
+// ---------------------------------------------
+// AoS vs SoA – SORTING BY ONE KEY
+// ---------------------------------------------
+
+/*
+   Layout also decides what a reorder costs. Book rebuilds sort millions of
+   entries by one key, so this mode sorts particles by x three ways
+   (./soa_vs_aos --mode=sort):
+
+   - AoS std::sort        : swaps whole 12-byte records, ~log2(n) passes
+   - SoA index sort       : std::sort of a 4-byte permutation comparing
+                            x[a] < x[b] (random key loads), then one gather
+                            pass per column
+   - SoA radix sort       : LSD radix on (x bits, index) pairs, 4 passes of
+                            8-bit digits, then the same gather
+
+   Next to the time each run prints an estimate of the bytes it moves
+   (model in sort_layouts.cpp) and, where perf counters work, LLC load
+   misses × 64 B.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "huge_pages.hpp"
+
+void runSortBenchmark(size_t count, PagePolicy policy);
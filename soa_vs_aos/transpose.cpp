@@ -0,0 +1,295 @@
+#include "transpose.hpp"
+
+#include <immintrin.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+constexpr size_t TRANSPOSE_BATCH = 8;
+
+// ---- scalar ----
+
+static void aosToSoAScalar(const float* records, size_t begin, size_t end, size_t fields, float* const* columns) {
+    for (size_t i = begin; i < end; ++i) {
+        for (size_t f = 0; f < fields; ++f) columns[f][i] = records[i * fields + f];
+    }
+}
+
+static void soaToAoSScalar(const float* const* columns, size_t begin, size_t end, size_t fields, float* records) {
+    for (size_t i = begin; i < end; ++i) {
+        for (size_t f = 0; f < fields; ++f) records[i * fields + f] = columns[f][i];
+    }
+}
+
+// ---- AVX2: 3 fields ----
+
+// v0..v2 hold x0 y0 z0 x1 y1 z1 x2 y2 | z2 x3 y3 z3 x4 y4 z4 x5 | y5 z5 x6 y6 z6 x7 y7 z7.
+// Each field's 8 values sit in 8 distinct slots across v0..v2, so two blends
+// collect them into one register and one permute sorts them.
+__attribute__((target("avx2")))
+static void aosToSoA3(const float* records, size_t count, float* const* columns) {
+    const __m256i xOrder = _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5);
+    const __m256i yOrder = _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6);
+    const __m256i zOrder = _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7);
+    size_t i = 0;
+    for (; i + TRANSPOSE_BATCH <= count; i += TRANSPOSE_BATCH) {
+        const float* in = records + i * 3;
+        __m256 v0 = _mm256_loadu_ps(in);
+        __m256 v1 = _mm256_loadu_ps(in + 8);
+        __m256 v2 = _mm256_loadu_ps(in + 16);
+
+        __m256 x = _mm256_blend_ps(_mm256_blend_ps(v0, v1, 0x92), v2, 0x24);
+        __m256 y = _mm256_blend_ps(_mm256_blend_ps(v0, v1, 0x24), v2, 0x49);
+        __m256 z = _mm256_blend_ps(_mm256_blend_ps(v0, v1, 0x49), v2, 0x92);
+
+        _mm256_storeu_ps(columns[0] + i, _mm256_permutevar8x32_ps(x, xOrder));
+        _mm256_storeu_ps(columns[1] + i, _mm256_permutevar8x32_ps(y, yOrder));
+        _mm256_storeu_ps(columns[2] + i, _mm256_permutevar8x32_ps(z, zOrder));
+    }
+    aosToSoAScalar(records, i, count, 3, columns);
+}
+
+// Exact inverse: permute each column into its record slots, then blend.
+__attribute__((target("avx2")))
+static void soaToAoS3(const float* const* columns, size_t count, float* records) {
+    const __m256i xSlots = _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5);
+    const __m256i ySlots = _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2);
+    const __m256i zSlots = _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7);
+    size_t i = 0;
+    for (; i + TRANSPOSE_BATCH <= count; i += TRANSPOSE_BATCH) {
+        __m256 x = _mm256_permutevar8x32_ps(_mm256_loadu_ps(columns[0] + i), xSlots);
+        __m256 y = _mm256_permutevar8x32_ps(_mm256_loadu_ps(columns[1] + i), ySlots);
+        __m256 z = _mm256_permutevar8x32_ps(_mm256_loadu_ps(columns[2] + i), zSlots);
+
+        float* out = records + i * 3;
+        _mm256_storeu_ps(out, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x92), z, 0x24));
+        _mm256_storeu_ps(out + 8, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x24), z, 0x49));
+        _mm256_storeu_ps(out + 16, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x49), z, 0x92));
+    }
+    soaToAoSScalar(columns, i, count, 3, records);
+}
+
+// ---- AVX2: 4 fields ----
+
+__attribute__((target("avx2")))
+static void aosToSoA4(const float* records, size_t count, float* const* columns) {
+    // unpack leaves lane 0 with records 0,2,4,6 and lane 1 with 1,3,5,7.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + TRANSPOSE_BATCH <= count; i += TRANSPOSE_BATCH) {
+        const float* in = records + i * 4;
+        __m256 r0 = _mm256_loadu_ps(in);
+        __m256 r1 = _mm256_loadu_ps(in + 8);
+        __m256 r2 = _mm256_loadu_ps(in + 16);
+        __m256 r3 = _mm256_loadu_ps(in + 24);
+
+        __m256d t0 = _mm256_castps_pd(_mm256_unpacklo_ps(r0, r1)); // x0 x2 y0 y2 | x1 x3 y1 y3
+        __m256d t1 = _mm256_castps_pd(_mm256_unpackhi_ps(r0, r1)); // z0 z2 w0 w2 | z1 z3 w1 w3
+        __m256d t2 = _mm256_castps_pd(_mm256_unpacklo_ps(r2, r3));
+        __m256d t3 = _mm256_castps_pd(_mm256_unpackhi_ps(r2, r3));
+
+        __m256 x = _mm256_castpd_ps(_mm256_unpacklo_pd(t0, t2));
+        __m256 y = _mm256_castpd_ps(_mm256_unpackhi_pd(t0, t2));
+        __m256 z = _mm256_castpd_ps(_mm256_unpacklo_pd(t1, t3));
+        __m256 w = _mm256_castpd_ps(_mm256_unpackhi_pd(t1, t3));
+
+        _mm256_storeu_ps(columns[0] + i, _mm256_permutevar8x32_ps(x, order));
+        _mm256_storeu_ps(columns[1] + i, _mm256_permutevar8x32_ps(y, order));
+        _mm256_storeu_ps(columns[2] + i, _mm256_permutevar8x32_ps(z, order));
+        _mm256_storeu_ps(columns[3] + i, _mm256_permutevar8x32_ps(w, order));
+    }
+    aosToSoAScalar(records, i, count, 4, columns);
+}
+
+__attribute__((target("avx2")))
+static void soaToAoS4(const float* const* columns, size_t count, float* records) {
+    size_t i = 0;
+    for (; i + TRANSPOSE_BATCH <= count; i += TRANSPOSE_BATCH) {
+        __m256 x = _mm256_loadu_ps(columns[0] + i);
+        __m256 y = _mm256_loadu_ps(columns[1] + i);
+        __m256 z = _mm256_loadu_ps(columns[2] + i);
+        __m256 w = _mm256_loadu_ps(columns[3] + i);
+
+        __m256 t0 = _mm256_unpacklo_ps(x, y); // x0 y0 x1 y1 | x4 y4 x5 y5
+        __m256 t1 = _mm256_unpackhi_ps(x, y); // x2 y2 x3 y3 | x6 y6 x7 y7
+        __m256 t2 = _mm256_unpacklo_ps(z, w);
+        __m256 t3 = _mm256_unpackhi_ps(z, w);
+
+        __m256 a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)); // record 0 | record 4
+        __m256 b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)); // record 1 | record 5
+        __m256 c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)); // record 2 | record 6
+        __m256 d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)); // record 3 | record 7
+
+        float* out = records + i * 4;
+        _mm256_storeu_ps(out, _mm256_permute2f128_ps(a, b, 0x20));
+        _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(c, d, 0x20));
+        _mm256_storeu_ps(out + 16, _mm256_permute2f128_ps(a, b, 0x31));
+        _mm256_storeu_ps(out + 24, _mm256_permute2f128_ps(c, d, 0x31));
+    }
+    soaToAoSScalar(columns, i, count, 4, records);
+}
+
+// ---- AVX2: 8 fields ----
+
+// In-register 8×8 transpose; its own inverse, so both directions share it.
+__attribute__((target("avx2")))
+static void transpose8x8(__m256 r[8]) {
+    __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+    __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+    __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+__attribute__((target("avx2")))
+static void aosToSoA8(const float* records, size_t count, float* const* columns) {
+    size_t i = 0;
+    for (; i + TRANSPOSE_BATCH <= count; i += TRANSPOSE_BATCH) {
+        __m256 r[8];
+        for (size_t k = 0; k < 8; ++k) r[k] = _mm256_loadu_ps(records + (i + k) * 8);
+        transpose8x8(r);
+        for (size_t f = 0; f < 8; ++f) _mm256_storeu_ps(columns[f] + i, r[f]);
+    }
+    aosToSoAScalar(records, i, count, 8, columns);
+}
+
+__attribute__((target("avx2")))
+static void soaToAoS8(const float* const* columns, size_t count, float* records) {
+    size_t i = 0;
+    for (; i + TRANSPOSE_BATCH <= count; i += TRANSPOSE_BATCH) {
+        __m256 r[8];
+        for (size_t f = 0; f < 8; ++f) r[f] = _mm256_loadu_ps(columns[f] + i);
+        transpose8x8(r);
+        for (size_t k = 0; k < 8; ++k) _mm256_storeu_ps(records + (i + k) * 8, r[k]);
+    }
+    soaToAoSScalar(columns, i, count, 8, records);
+}
+
+// ---- dispatch ----
+
+void aosToSoA(const float* records, size_t count, size_t fields, float* const* columns, SimdLevel level) {
+    if (level >= SimdLevel::Avx2) {
+        switch (fields) {
+            case 3: return aosToSoA3(records, count, columns);
+            case 4: return aosToSoA4(records, count, columns);
+            case 8: return aosToSoA8(records, count, columns);
+        }
+    }
+    aosToSoAScalar(records, 0, count, fields, columns);
+}
+
+void soaToAoS(const float* const* columns, size_t count, size_t fields, float* records, SimdLevel level) {
+    if (level >= SimdLevel::Avx2) {
+        switch (fields) {
+            case 3: return soaToAoS3(columns, count, records);
+            case 4: return soaToAoS4(columns, count, records);
+            case 8: return soaToAoS8(columns, count, records);
+        }
+    }
+    soaToAoSScalar(columns, 0, count, fields, records);
+}
+
+// ---- benchmark ----
+
+template<typename Kernel>
+double timeTranspose(const std::string& label, size_t bytes, Kernel kernel) {
+    auto start = std::chrono::high_resolution_clock::now();
+    kernel();
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "   " << label << " took: " << static_cast<long long>(seconds * 1000) << " ms, "
+              << bytes / seconds / 1e9 << " GB/s\n";
+    return seconds * 1000;
+}
+
+void benchmarkFieldCount(size_t count, size_t fields, PagePolicy policy, SimdLevel level) {
+    std::cout << "\n " << fields << " fields (" << fields * sizeof(float) << "-byte records):\n";
+
+    PageArray<float> records(count * fields, policy);
+    PageArray<float> roundTrip(count * fields, policy);
+    std::vector<PageArray<float>> columns;
+    std::vector<float*> columnPtrs;
+    for (size_t f = 0; f < fields; ++f) {
+        columns.emplace_back(count, policy);
+        columnPtrs.push_back(columns.back().data());
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (size_t i = 0; i < count * fields; ++i) records[i] = dist(rng);
+
+    // Touch every destination page once so the timings below are copies, not page faults.
+    aosToSoA(records.data(), count, fields, columnPtrs.data(), SimdLevel::Scalar);
+    soaToAoS(columnPtrs.data(), count, fields, roundTrip.data(), SimdLevel::Scalar);
+
+    // Read + write of every byte.
+    size_t bytes = 2 * count * fields * sizeof(float);
+    std::string simdName = simdLevelName(level == SimdLevel::Scalar ? SimdLevel::Scalar : SimdLevel::Avx2);
+
+    timeTranspose("AoS→SoA scalar", bytes,
+                  [&] { aosToSoA(records.data(), count, fields, columnPtrs.data(), SimdLevel::Scalar); });
+    double toSoA = timeTranspose("AoS→SoA " + simdName, bytes,
+                                 [&] { aosToSoA(records.data(), count, fields, columnPtrs.data(), level); });
+    timeTranspose("SoA→AoS scalar", bytes,
+                  [&] { soaToAoS(columnPtrs.data(), count, fields, roundTrip.data(), SimdLevel::Scalar); });
+    timeTranspose("SoA→AoS " + simdName, bytes,
+                  [&] { soaToAoS(columnPtrs.data(), count, fields, roundTrip.data(), level); });
+
+    if (std::memcmp(records.data(), roundTrip.data(), count * fields * sizeof(float)) != 0) {
+        std::cerr << "   ❌ round trip does not reproduce the input\n";
+    }
+
+    // Amortisation: one pass of a one-field sum, strided on AoS vs contiguous on SoA.
+    ColumnSumFn column = selectColumnSum(level);
+    StridedSumFn strided = selectStridedSum(level);
+    float sink = 0.0f;
+    double aosPass = timeTranspose("AoS field-0 sum", count * fields * sizeof(float),
+                                   [&] { sink += strided(records.data(), count, fields); });
+    double soaPass = timeTranspose("SoA field-0 sum", count * sizeof(float),
+                                   [&] { sink += column(columnPtrs[0], count); });
+
+    std::cout << "   → ";
+    if (aosPass > soaPass) {
+        std::cout << "converting pays off after " << toSoA / (aosPass - soaPass) << " passes";
+    } else {
+        std::cout << "a pass is no faster on SoA here, converting never pays off";
+    }
+    std::cout << " (checksum " << sink << ")\n";
+}
+
+void runTransposeBenchmark(size_t count, PagePolicy policy, const std::string& simd) {
+    SimdLevel detected = detectSimdLevel();
+    SimdLevel requested = parseSimdLevel(simd);
+    if (requested > detected) {
+        std::cerr << simdLevelName(requested) << " requested but this CPU only supports "
+                  << simdLevelName(detected) << ", falling back.\n";
+        requested = detected;
+    }
+
+    std::cout << "\n🔀 AoS ⇄ SoA transposition over " << count << " records\n";
+    for (size_t fields : {3, 4, 8}) benchmarkFieldCount(count, fields, policy, requested);
+}
@@ -0,0 +1,35 @@
+// ---------------------------------------------
+// AoS vs SoA – TRANSPOSITION (AoS ⇄ SoA)
+// ---------------------------------------------
+
+/*
+   Data arrives from the wire as packed records, but the analytics want
+   columns. These routines convert batches of float records with 3, 4 or
+   8 fields between the two layouts, 8 records per step:
+
+   - 4 fields : 4×8 floats, a 4×4 in-lane transpose (unpack + permute)
+   - 8 fields : a full 8×8 register transpose (unpack, shuffle, permute2f128)
+   - 3 fields : 3 registers hold x0 y0 z0 x1 … z7; one blend pair gathers
+                each field into distinct slots and one permutevar8x32 puts
+                them in order (and the same in reverse)
+
+   Other field counts, the tail (count % 8) and --simd=scalar use plain loops.
+   AVX-512 machines run the AVX2 path.
+
+   ./soa_vs_aos --mode=transpose [--records=N] times both directions and
+   how many passes of a one-field kernel it takes to win the cost back.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "huge_pages.hpp"
+#include "simd_reductions.hpp"
+
+// records: count × fields floats; columns: `fields` arrays of `count` floats.
+void aosToSoA(const float* records, size_t count, size_t fields, float* const* columns, SimdLevel level);
+void soaToAoS(const float* const* columns, size_t count, size_t fields, float* records, SimdLevel level);
+
+void runTransposeBenchmark(size_t count, PagePolicy policy, const std::string& simd);